@@ -0,0 +1,87 @@
+/*
+ * FreeRTOSConfig.h de la simulación en Linux (port GCC/Posix del kernel).
+ * Replica lo que afecta al comportamiento de la aplicación en
+ * source/COMPONENT_FREERTOS/configs/FreeRTOSConfig.h: prioridades, tick,
+ * mutex, registro de colas, heap_5 con traceMALLOC y el registrador de trazas.
+ * Lo propio del Cortex-M (prioridades de NVIC, tickless, newlib) no aplica.
+ */
+
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define configUSE_PREEMPTION                    1
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION 0
+#define configCPU_CLOCK_HZ                      1000000000u
+#define configTICK_RATE_HZ                      1000u
+#define configMAX_PRIORITIES                    7
+#define configMINIMAL_STACK_SIZE                ( PTHREAD_STACK_MIN / sizeof( StackType_t ) )
+#define configMAX_TASK_NAME_LEN                 16
+#define configUSE_16_BIT_TICKS                  0
+#define configIDLE_SHOULD_YIELD                 1
+#define configUSE_TASK_NOTIFICATIONS            1
+#define configTASK_NOTIFICATION_ARRAY_ENTRIES   2   /* 1: recepción de clientes (tcp_server.c) */
+#define configUSE_MUTEXES                       1
+#define configUSE_RECURSIVE_MUTEXES             1
+#define configUSE_COUNTING_SEMAPHORES           1
+#define configQUEUE_REGISTRY_SIZE               10
+#define configUSE_QUEUE_SETS                    0
+#define configUSE_TIME_SLICING                  1
+#define configENABLE_BACKWARD_COMPATIBILITY     0
+#define configNUM_THREAD_LOCAL_STORAGE_POINTERS 16
+#define configSUPPORT_STATIC_ALLOCATION         1
+#define configSUPPORT_DYNAMIC_ALLOCATION        1
+#define configKERNEL_PROVIDED_STATIC_MEMORY     1   /* Kernel >= 11.1; si no, host_board.c */
+#define configTOTAL_HEAP_SIZE                   10240   /* Sin efecto con heap_5: ver heap_monitor.c */
+#define configAPPLICATION_ALLOCATED_HEAP        0
+#define configUSE_IDLE_HOOK                     0
+#define configUSE_TICK_HOOK                     0
+#define configCHECK_FOR_STACK_OVERFLOW          0   /* Las pilas son de pthreads */
+#define configUSE_MALLOC_FAILED_HOOK            1
+#define configUSE_DAEMON_TASK_STARTUP_HOOK      0
+#define configGENERATE_RUN_TIME_STATS           0
+#define configUSE_TRACE_FACILITY                1
+#define configUSE_STATS_FORMATTING_FUNCTIONS    0
+#define configUSE_CO_ROUTINES                   0
+#define configMAX_CO_ROUTINE_PRIORITIES         2
+#define configUSE_TIMERS                        1
+#define configTIMER_TASK_PRIORITY               2
+#define configTIMER_QUEUE_LENGTH                10
+#define configTIMER_TASK_STACK_DEPTH            ( configMINIMAL_STACK_SIZE * 2 )
+#define configUSE_NEWLIB_REENTRANT              0
+#define configUSE_TICKLESS_IDLE                 0
+
+#define INCLUDE_vTaskPrioritySet                1
+#define INCLUDE_uxTaskPriorityGet               1
+#define INCLUDE_vTaskDelete                     1
+#define INCLUDE_vTaskSuspend                    1
+#define INCLUDE_xResumeFromISR                  1
+#define INCLUDE_vTaskDelayUntil                 1
+#define INCLUDE_vTaskDelay                      1
+#define INCLUDE_xTaskGetSchedulerState          1
+#define INCLUDE_xTaskGetCurrentTaskHandle       1
+#define INCLUDE_uxTaskGetStackHighWaterMark     1
+#define INCLUDE_xTaskGetIdleTaskHandle          0
+#define INCLUDE_eTaskGetState                   0
+#define INCLUDE_xEventGroupSetBitFromISR        1
+#define INCLUDE_xTimerPendFunctionCall          1
+#define INCLUDE_xTaskAbortDelay                 0
+#define INCLUDE_xTaskGetHandle                  0
+#define INCLUDE_xTaskResumeFromISR              1
+
+#define configASSERT( x ) \
+    if( ( x ) == 0 ) { fprintf( stderr, "configASSERT en %s:%d\n", __FILE__, __LINE__ ); abort(); }
+
+/* heap_5 y contador de asignaciones, igual que en la placa */
+#define configHEAP_ALLOCATION_SCHEME            ( 5 )
+extern void heap_monitor_on_malloc( void *ptr, size_t size );
+#define traceMALLOC( pvAddress, uiSize )        heap_monitor_on_malloc( ( pvAddress ), ( uiSize ) )
+
+#if defined(APP_TRACE_RECORDER)
+#include "trace_recorder_hooks.h"
+#endif
+
+#endif /* FREERTOS_CONFIG_H */
@@ -0,0 +1,51 @@
+#ifndef HOST_ARM_MATH_H_
+#define HOST_ARM_MATH_H_
+
+// Sustituto de CMSIS-DSP para la simulación en Linux: solo las funciones que
+// usa ../source, en C portable y con los mismos resultados que la versión
+// escalar de la biblioteca (sin ARM_MATH_DSP).
+
+#include <stdint.h>
+
+typedef int16_t q15_t;
+typedef int32_t q31_t;
+typedef int64_t q63_t;
+typedef float float32_t;
+
+typedef enum
+{
+    ARM_MATH_SUCCESS = 0,
+    ARM_MATH_ARGUMENT_ERROR = -1
+} arm_status;
+
+typedef struct
+{
+    uint16_t fftLenRFFT;
+} arm_rfft_fast_instance_f32;
+
+typedef struct
+{
+    uint32_t fftLenReal;
+} arm_rfft_instance_q31;
+
+void arm_q15_to_float(const q15_t *pSrc, float32_t *pDst, uint32_t blockSize);
+void arm_scale_f32(const float32_t *pSrc, float32_t scale, float32_t *pDst, uint32_t blockSize);
+void arm_clip_f32(const float32_t *pSrc, float32_t *pDst, float32_t low, float32_t high, uint32_t numSamples);
+void arm_absmax_q15(const q15_t *pSrc, uint32_t blockSize, q15_t *pResult, uint32_t *pIndex);
+void arm_cmplx_mag_f32(const float32_t *pSrc, float32_t *pDst, uint32_t numSamples);
+void arm_float_to_q15(const float32_t *pSrc, q15_t *pDst, uint32_t blockSize);
+void arm_scale_q15(const q15_t *pSrc, q15_t scaleFract, int8_t shift, q15_t *pDst, uint32_t blockSize);
+arm_status arm_sqrt_q31(q31_t in, q31_t *pOut);
+
+// FFT real: salida empaquetada como CMSIS {X[0], X[N/2]} y luego X[1..N/2-1]
+// como re, im. pSrc se usa como espacio de trabajo.
+arm_status arm_rfft_fast_init_512_f32(arm_rfft_fast_instance_f32 *S);
+void arm_rfft_fast_f32(const arm_rfft_fast_instance_f32 *S, float32_t *p, float32_t *pOut, uint8_t ifftFlag);
+
+// FFT real Q31 con el escalado de CMSIS: la salida es X/N (10.22 para 512) y
+// ocupa 2N valores, X[k] en [2k, 2k + 1] con la mitad conjugada incluida. No
+// reproduce bit a bit el redondeo de CMSIS, sí su orden de magnitud.
+arm_status arm_rfft_init_512_q31(arm_rfft_instance_q31 *S, uint32_t ifftFlagR, uint32_t bitReverseFlag);
+void arm_rfft_q31(const arm_rfft_instance_q31 *S, q31_t *pSrc, q31_t *pDst);
+
+#endif /* HOST_ARM_MATH_H_ */
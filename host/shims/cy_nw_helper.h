@@ -0,0 +1,8 @@
+#ifndef HOST_CY_NW_HELPER_H_
+#define HOST_CY_NW_HELPER_H_
+
+// ../source no usa nada de cy_nw_helper; existe para que compilen los include
+
+#include "cyhal.h"
+
+#endif /* HOST_CY_NW_HELPER_H_ */
@@ -0,0 +1,11 @@
+#ifndef HOST_CY_RETARGET_IO_H_
+#define HOST_CY_RETARGET_IO_H_
+
+#include "cyhal.h"
+
+#define CY_RETARGET_IO_BAUDRATE 115200
+
+// La consola es stdout del proceso, sin buffer
+cy_rslt_t cy_retarget_io_init(cyhal_gpio_t tx, cyhal_gpio_t rx, uint32_t baudrate);
+
+#endif /* HOST_CY_RETARGET_IO_H_ */
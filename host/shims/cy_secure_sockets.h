@@ -0,0 +1,97 @@
+#ifndef HOST_CY_SECURE_SOCKETS_H_
+#define HOST_CY_SECURE_SOCKETS_H_
+
+// cy_secure_sockets sobre sockets BSD (solo TCP/IPv4, sin TLS). Los
+// descriptores son no bloqueantes y las esperas se hacen con poll() +
+// vTaskDelay(1): una llamada bloqueante dentro de una tarea del port POSIX
+// detendría al scheduler entero.
+//
+// HOST_PORT_OFFSET se suma a cada puerto en bind, para no necesitar root con
+// los puertos < 1024 (TCP_PORT 599, echo 7...).
+
+#include "cyhal.h"
+
+typedef void *cy_socket_t;
+
+#define CY_SOCKET_INVALID_HANDLE ((cy_socket_t)(intptr_t)-1)
+
+typedef enum
+{
+    CY_SOCKET_IP_VER_V4 = 4,
+    CY_SOCKET_IP_VER_V6 = 6
+} cy_socket_ip_version_t;
+
+typedef struct
+{
+    cy_socket_ip_version_t version;
+    union
+    {
+        uint32_t v4; // Orden de red, como lwIP
+        uint32_t v6[4];
+    } ip;
+} cy_socket_ip_address_t;
+
+typedef struct
+{
+    uint16_t port;
+    cy_socket_ip_address_t ip_address;
+} cy_socket_sockaddr_t;
+
+#define CY_SOCKET_DOMAIN_AF_INET 2
+#define CY_SOCKET_TYPE_STREAM 1
+#define CY_SOCKET_IPPROTO_TCP 6
+
+#define CY_SOCKET_FLAGS_NONE 0x0
+#define CY_SOCKET_NEVER_TIMEOUT 0xFFFFFFFFu
+#define CY_SOCKET_DEFAULT_RECEIVE_TIMEOUT 10000u
+#define CY_SOCKET_DEFAULT_SEND_TIMEOUT 10000u
+
+#define CY_SOCKET_SOL_SOCKET 1
+#define CY_SOCKET_SOL_TCP 2
+
+#define CY_SOCKET_SO_RCVTIMEO 0
+#define CY_SOCKET_SO_SNDTIMEO 1
+#define CY_SOCKET_SO_NONBLOCK 2
+#define CY_SOCKET_SO_TCP_NODELAY 3
+#define CY_SOCKET_SO_RECEIVE_CALLBACK 4         // Sin hilo que vigile los fd: BADARG
+#define CY_SOCKET_SO_CONNECT_REQUEST_CALLBACK 5 // Idem
+
+typedef cy_rslt_t (*cy_socket_callback_t)(cy_socket_t socket_handle, void *arg);
+
+typedef struct
+{
+    cy_socket_callback_t callback;
+    void *arg;
+} cy_socket_opt_callback_t;
+
+#define CY_RSLT_MODULE_SECURE_SOCKETS (0x0202u)
+#define CY_SECURE_SOCKETS_RSLT(code) CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, CY_RSLT_MODULE_SECURE_SOCKETS, (code))
+
+#define CY_RSLT_MODULE_SECURE_SOCKETS_BADARG CY_SECURE_SOCKETS_RSLT(1)
+#define CY_RSLT_MODULE_SECURE_SOCKETS_NOMEM CY_SECURE_SOCKETS_RSLT(3)
+#define CY_RSLT_MODULE_SECURE_SOCKETS_INVALID_SOCKET CY_SECURE_SOCKETS_RSLT(5)
+#define CY_RSLT_MODULE_SECURE_SOCKETS_TIMEOUT CY_SECURE_SOCKETS_RSLT(9)
+#define CY_RSLT_MODULE_SECURE_SOCKETS_PROTOCOL_NOT_SUPPORTED CY_SECURE_SOCKETS_RSLT(10)
+#define CY_RSLT_MODULE_SECURE_SOCKETS_ADDRESS_IN_USE CY_SECURE_SOCKETS_RSLT(12)
+#define CY_RSLT_MODULE_SECURE_SOCKETS_HOST_NOT_FOUND CY_SECURE_SOCKETS_RSLT(14)
+#define CY_RSLT_MODULE_SECURE_SOCKETS_CLOSED CY_SECURE_SOCKETS_RSLT(16)
+#define CY_RSLT_MODULE_SECURE_SOCKETS_WOULDBLOCK CY_SECURE_SOCKETS_RSLT(23)
+#define CY_RSLT_MODULE_SECURE_SOCKETS_TCPIP_ERROR CY_SECURE_SOCKETS_RSLT(24)
+
+cy_rslt_t cy_socket_init(void);
+cy_rslt_t cy_socket_deinit(void);
+cy_rslt_t cy_socket_create(int domain, int type, int protocol, cy_socket_t *handle);
+cy_rslt_t cy_socket_setsockopt(cy_socket_t handle, int level, int optname,
+                               const void *optval, uint32_t optlen);
+cy_rslt_t cy_socket_bind(cy_socket_t handle, cy_socket_sockaddr_t *address, uint32_t address_length);
+cy_rslt_t cy_socket_listen(cy_socket_t handle, int backlog);
+cy_rslt_t cy_socket_accept(cy_socket_t handle, cy_socket_sockaddr_t *address,
+                           uint32_t *address_length, cy_socket_t *socket);
+cy_rslt_t cy_socket_send(cy_socket_t handle, const void *buffer, uint32_t length, int flags,
+                         uint32_t *bytes_sent);
+cy_rslt_t cy_socket_recv(cy_socket_t handle, void *buffer, uint32_t length, int flags,
+                         uint32_t *bytes_received);
+cy_rslt_t cy_socket_disconnect(cy_socket_t handle, uint32_t timeout);
+cy_rslt_t cy_socket_delete(cy_socket_t handle);
+
+#endif /* HOST_CY_SECURE_SOCKETS_H_ */
@@ -0,0 +1,63 @@
+#ifndef HOST_CY_WCM_H_
+#define HOST_CY_WCM_H_
+
+// Wi-Fi simulado: cy_wcm_connect_ap siempre conecta y devuelve la dirección
+// de HOST_BIND_ADDR (por defecto 0.0.0.0, todas las interfaces)
+
+#include "cyhal.h"
+
+typedef enum
+{
+    CY_WCM_INTERFACE_TYPE_STA = 0,
+    CY_WCM_INTERFACE_TYPE_AP,
+    CY_WCM_INTERFACE_TYPE_AP_STA
+} cy_wcm_interface_t;
+
+typedef enum
+{
+    CY_WCM_SECURITY_OPEN = 0,
+    CY_WCM_SECURITY_WPA2_AES_PSK = 0x00400004,
+    CY_WCM_SECURITY_WPA3_SAE = 0x01000004
+} cy_wcm_security_t;
+
+typedef enum
+{
+    CY_WCM_IP_VER_V4 = 4,
+    CY_WCM_IP_VER_V6 = 6
+} cy_wcm_ip_version_t;
+
+typedef struct
+{
+    cy_wcm_interface_t interface;
+} cy_wcm_config_t;
+
+typedef uint8_t cy_wcm_ssid_t[32 + 1];
+typedef uint8_t cy_wcm_passphrase_t[64 + 1];
+
+typedef struct
+{
+    cy_wcm_ssid_t SSID;
+    cy_wcm_passphrase_t password;
+    cy_wcm_security_t security;
+} cy_wcm_ap_credentials_t;
+
+typedef struct
+{
+    cy_wcm_ap_credentials_t ap_credentials;
+    uint8_t BSSID[6];
+} cy_wcm_connect_params_t;
+
+typedef struct
+{
+    cy_wcm_ip_version_t version;
+    union
+    {
+        uint32_t v4; // Orden de red
+        uint32_t v6[4];
+    } ip;
+} cy_wcm_ip_address_t;
+
+cy_rslt_t cy_wcm_init(cy_wcm_config_t *config);
+cy_rslt_t cy_wcm_connect_ap(cy_wcm_connect_params_t *connect_params, cy_wcm_ip_address_t *ip_addr);
+
+#endif /* HOST_CY_WCM_H_ */
@@ -0,0 +1,11 @@
+#ifndef HOST_CYABS_RTOS_H_
+#define HOST_CYABS_RTOS_H_
+
+// Igual que el cyabs_rtos.h de FreeRTOS: solo arrastra los headers del kernel
+#include "cyhal.h"
+#include <FreeRTOS.h>
+#include <task.h>
+#include <queue.h>
+#include <semphr.h>
+
+#endif /* HOST_CYABS_RTOS_H_ */
@@ -0,0 +1,13 @@
+#ifndef HOST_CYBSP_H_
+#define HOST_CYBSP_H_
+
+#include "cyhal.h"
+
+#define CYBSP_DEBUG_UART_TX P5_1
+#define CYBSP_DEBUG_UART_RX P5_0
+
+// Prepara el proceso: registros mapeados que toca ../source, señales y
+// HOST_RUN_SECONDS
+cy_rslt_t cybsp_init(void);
+
+#endif /* HOST_CYBSP_H_ */
@@ -0,0 +1,204 @@
+#ifndef HOST_CYHAL_H_
+#define HOST_CYHAL_H_
+
+// Sustituto de cyhal.h para la simulación en Linux (host/Makefile). Declara
+// solo lo que usa ../source: tipos de resultado, CMSIS mínimo (DWT, IRQ),
+// GPIO registrado en memoria, relojes sin efecto y PDM/PCM leído de un WAV.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// RESULTADOS (mismo formato que cy_result.h)
+typedef uint32_t cy_rslt_t;
+
+#define CY_RSLT_SUCCESS ((cy_rslt_t)0u)
+#define CY_RSLT_TYPE_INFO (0u)
+#define CY_RSLT_TYPE_WARNING (1u)
+#define CY_RSLT_TYPE_ERROR (2u)
+#define CY_RSLT_TYPE_FATAL (3u)
+#define CY_RSLT_CREATE(type, module, code) \
+    ((((module) & 0x3FFFu) << 18) | (((code) & 0xFFFFu) << 0) | (((type) & 0x3u) << 16))
+
+#define CY_RSLT_MODULE_HOST_SIM (0x3F00u)
+#define CY_RSLT_HOST_ERROR CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, CY_RSLT_MODULE_HOST_SIM, 1)
+
+#define CY_UNUSED_PARAMETER(x) ((void)(x))
+#define CY_HALT() abort()
+#define CY_ASSERT(x)                                                             \
+    do                                                                           \
+    {                                                                            \
+        if (!(x))                                                                \
+        {                                                                        \
+            fprintf(stderr, "CY_ASSERT(%s) en %s:%d\n", #x, __FILE__, __LINE__); \
+            abort();                                                             \
+        }                                                                        \
+    } while (0)
+
+// CMSIS: el contador de ciclos del DWT se emula con CLOCK_MONOTONIC a 1 GHz
+// (un "ciclo" por nanosegundo). Cada lectura de DWT refresca CYCCNT.
+typedef struct
+{
+    volatile uint32_t CTRL;
+    volatile uint32_t CYCCNT;
+} DWT_Type;
+
+typedef struct
+{
+    volatile uint32_t DEMCR;
+} CoreDebug_Type;
+
+#define DWT_CTRL_CYCCNTENA_Msk (1u << 0)
+#define CoreDebug_DEMCR_TRCENA_Msk (1u << 24)
+
+DWT_Type *host_dwt_sample(void);
+extern CoreDebug_Type host_core_debug;
+extern uint32_t SystemCoreClock;
+
+#define DWT (host_dwt_sample())
+#define CoreDebug (&host_core_debug)
+
+static inline void __enable_irq(void) {}
+static inline void __disable_irq(void) {}
+
+// GPIO: pines codificados como puerto * 8 + pin
+typedef uint32_t cyhal_gpio_t;
+
+#define CYHAL_GET_GPIO(port, pin) ((cyhal_gpio_t)((port) * 8u + (pin)))
+#define CYHAL_GET_PORT(gpio) ((gpio) / 8u)
+#define CYHAL_GET_PIN(gpio) ((gpio) % 8u)
+#define NC ((cyhal_gpio_t)0xFFFFFFFFu)
+
+#define P5_0 CYHAL_GET_GPIO(5, 0)
+#define P5_1 CYHAL_GET_GPIO(5, 1)
+#define P9_0 CYHAL_GET_GPIO(9, 0)
+#define P9_1 CYHAL_GET_GPIO(9, 1)
+#define P9_2 CYHAL_GET_GPIO(9, 2)
+#define P9_3 CYHAL_GET_GPIO(9, 3)
+#define P10_4 CYHAL_GET_GPIO(10, 4)
+#define P10_5 CYHAL_GET_GPIO(10, 5)
+
+typedef enum
+{
+    CYHAL_GPIO_DIR_INPUT,
+    CYHAL_GPIO_DIR_OUTPUT,
+    CYHAL_GPIO_DIR_BIDIRECTIONAL
+} cyhal_gpio_direction_t;
+
+typedef enum
+{
+    CYHAL_GPIO_DRIVE_NONE,
+    CYHAL_GPIO_DRIVE_ANALOG,
+    CYHAL_GPIO_DRIVE_PULLUP,
+    CYHAL_GPIO_DRIVE_PULLDOWN,
+    CYHAL_GPIO_DRIVE_OPENDRAINDRIVESLOW,
+    CYHAL_GPIO_DRIVE_OPENDRAINDRIVESHIGH,
+    CYHAL_GPIO_DRIVE_STRONG,
+    CYHAL_GPIO_DRIVE_PULLUPDOWN
+} cyhal_gpio_drive_mode_t;
+
+cy_rslt_t cyhal_gpio_init(cyhal_gpio_t pin, cyhal_gpio_direction_t direction,
+                          cyhal_gpio_drive_mode_t drive_mode, bool init_val);
+void cyhal_gpio_free(cyhal_gpio_t pin);
+void cyhal_gpio_write(cyhal_gpio_t pin, bool value);
+bool cyhal_gpio_read(cyhal_gpio_t pin);
+void cyhal_gpio_toggle(cyhal_gpio_t pin);
+
+// Registro de GPIO (solo simulación): escrituras, flancos y estado final
+void host_gpio_report(FILE *out);
+
+// RELOJES (sin efecto)
+typedef struct
+{
+    uint8_t block;
+    uint8_t channel;
+    uint32_t frequency_hz;
+} cyhal_clock_t;
+
+extern const cyhal_clock_t CYHAL_CLOCK_PLL[2];
+extern const cyhal_clock_t CYHAL_CLOCK_HF[2];
+
+typedef struct
+{
+    uint32_t tolerance;
+} cyhal_clock_tolerance_t;
+
+cy_rslt_t cyhal_clock_reserve(cyhal_clock_t *clock, const cyhal_clock_t *resource);
+cy_rslt_t cyhal_clock_set_frequency(cyhal_clock_t *clock, uint32_t hz, const cyhal_clock_tolerance_t *tolerance);
+cy_rslt_t cyhal_clock_set_enabled(cyhal_clock_t *clock, bool enabled, bool wait_for_lock);
+cy_rslt_t cyhal_clock_set_source(cyhal_clock_t *clock, const cyhal_clock_t *source);
+
+// PDM/PCM: muestras de HOST_WAV_FILE (16 bits PCM) entregadas a ritmo real,
+// por lectura directa o asíncrona con aviso de fin de bloque
+typedef enum
+{
+    CYHAL_PDM_PCM_MODE_LEFT,
+    CYHAL_PDM_PCM_MODE_RIGHT,
+    CYHAL_PDM_PCM_MODE_STEREO
+} cyhal_pdm_pcm_mode_t;
+
+typedef struct
+{
+    uint32_t sample_rate;
+    uint32_t decimation_rate;
+    cyhal_pdm_pcm_mode_t mode;
+    uint8_t word_length;
+    int16_t left_gain;
+    int16_t right_gain;
+} cyhal_pdm_pcm_cfg_t;
+
+typedef enum
+{
+    CYHAL_PDM_PCM_RX_HALF_FULL = 1 << 0,
+    CYHAL_PDM_PCM_RX_NOT_EMPTY = 1 << 1,
+    CYHAL_PDM_PCM_RX_OVERFLOW = 1 << 2,
+    CYHAL_PDM_PCM_RX_UNDERFLOW = 1 << 3,
+    CYHAL_PDM_PCM_ASYNC_COMPLETE = 1 << 4,
+} cyhal_pdm_pcm_event_t;
+
+typedef void (*cyhal_pdm_pcm_event_callback_t)(void *callback_arg, cyhal_pdm_pcm_event_t event);
+
+typedef enum
+{
+    CYHAL_ASYNC_SW,
+    CYHAL_ASYNC_DMA
+} cyhal_async_mode_t;
+
+#define CYHAL_DMA_PRIORITY_DEFAULT 3
+#define CYHAL_ISR_PRIORITY_DEFAULT 7
+
+typedef struct
+{
+    cyhal_pdm_pcm_cfg_t cfg;
+    bool running;
+    uint64_t start_ns;  // Instante de cyhal_pdm_pcm_start
+    uint64_t delivered; // Muestras entregadas desde el start
+    // Lectura asíncrona: la completa una tarea de mayor prioridad que hace de DMA
+    cyhal_pdm_pcm_event_callback_t callback;
+    void *callback_arg;
+    uint32_t events;    // Eventos habilitados
+    int16_t *async_data;
+    size_t async_length;
+    size_t async_filled;
+    void *dma_task;     // TaskHandle_t
+} cyhal_pdm_pcm_t;
+
+cy_rslt_t cyhal_pdm_pcm_init(cyhal_pdm_pcm_t *obj, cyhal_gpio_t pin_data, cyhal_gpio_t pin_clk,
+                             const cyhal_clock_t *clk_source, const cyhal_pdm_pcm_cfg_t *cfg);
+void cyhal_pdm_pcm_free(cyhal_pdm_pcm_t *obj);
+cy_rslt_t cyhal_pdm_pcm_start(cyhal_pdm_pcm_t *obj);
+cy_rslt_t cyhal_pdm_pcm_stop(cyhal_pdm_pcm_t *obj);
+cy_rslt_t cyhal_pdm_pcm_clear(cyhal_pdm_pcm_t *obj);
+cy_rslt_t cyhal_pdm_pcm_read(cyhal_pdm_pcm_t *obj, void *data, size_t *length);
+cy_rslt_t cyhal_pdm_pcm_set_async_mode(cyhal_pdm_pcm_t *obj, cyhal_async_mode_t mode, uint8_t dma_priority);
+void cyhal_pdm_pcm_register_callback(cyhal_pdm_pcm_t *obj, cyhal_pdm_pcm_event_callback_t callback,
+                                     void *callback_arg);
+void cyhal_pdm_pcm_enable_event(cyhal_pdm_pcm_t *obj, cyhal_pdm_pcm_event_t event, uint8_t intr_priority,
+                                bool enable);
+cy_rslt_t cyhal_pdm_pcm_read_async(cyhal_pdm_pcm_t *obj, void *data, size_t length);
+bool cyhal_pdm_pcm_is_pending(cyhal_pdm_pcm_t *obj);
+cy_rslt_t cyhal_pdm_pcm_abort_async(cyhal_pdm_pcm_t *obj);
+
+#endif /* HOST_CYHAL_H_ */
@@ -0,0 +1,310 @@
+#include "cyhal.h"
+#include <FreeRTOS.h>
+#include <task.h>
+#include <string.h>
+#include <time.h>
+
+// PDM/PCM simulado: HOST_WAV_FILE (PCM 16 bits, mono o estéreo; se toma el
+// canal izquierdo) se entrega en bucle al ritmo de cfg.sample_rate, como lo
+// haría la FIFO del micrófono. Sin archivo entrega silencio al mismo ritmo.
+// Las lecturas asíncronas las completa una tarea de máxima prioridad que hace
+// de DMA y llama al callback como lo haría la interrupción.
+
+#define HOST_PDM_FIFO_SAMPLES 254 // Profundidad de la FIFO del PDM/PCM de PSoC 6
+
+static int16_t *wav_samples = NULL;
+static size_t wav_count = 0;
+static size_t wav_position = 0;
+
+static uint64_t now_ns(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000u + (uint64_t)now.tv_nsec;
+}
+
+static uint32_t read_le32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint16_t read_le16(const uint8_t *p)
+{
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static bool load_wav(const char *path, uint32_t expected_rate)
+{
+    FILE *file = fopen(path, "rb");
+    uint8_t header[12];
+    uint16_t channels = 0;
+    uint16_t bits = 0;
+    uint32_t rate = 0;
+
+    if (file == NULL)
+    {
+        fprintf(stderr, "host: no se pudo abrir HOST_WAV_FILE %s\n", path);
+        return false;
+    }
+    if (fread(header, 1, sizeof(header), file) != sizeof(header) ||
+        memcmp(header, "RIFF", 4) != 0 || memcmp(header + 8, "WAVE", 4) != 0)
+    {
+        fprintf(stderr, "host: %s no es un WAV RIFF\n", path);
+        fclose(file);
+        return false;
+    }
+
+    // Recorre los chunks hasta "data"; "fmt " debe venir antes
+    for (;;)
+    {
+        uint8_t chunk[8];
+        if (fread(chunk, 1, sizeof(chunk), file) != sizeof(chunk))
+        {
+            fprintf(stderr, "host: %s sin chunk de datos\n", path);
+            fclose(file);
+            return false;
+        }
+        uint32_t size = read_le32(chunk + 4);
+
+        if (memcmp(chunk, "fmt ", 4) == 0)
+        {
+            uint8_t fmt[16];
+            if (size < sizeof(fmt) || fread(fmt, 1, sizeof(fmt), file) != sizeof(fmt))
+            {
+                break;
+            }
+            channels = read_le16(fmt + 2);
+            rate = read_le32(fmt + 4);
+            bits = read_le16(fmt + 14);
+            fseek(file, (long)(size - sizeof(fmt) + (size & 1)), SEEK_CUR);
+        }
+        else if (memcmp(chunk, "data", 4) == 0)
+        {
+            if (bits != 16 || channels == 0)
+            {
+                fprintf(stderr, "host: %s debe ser PCM de 16 bits\n", path);
+                break;
+            }
+
+            size_t frames = size / (2u * channels);
+            int16_t *raw = malloc(size);
+            wav_samples = malloc(frames * sizeof(int16_t));
+            if (raw == NULL || wav_samples == NULL || fread(raw, 1, size, file) != size)
+            {
+                free(raw);
+                free(wav_samples);
+                wav_samples = NULL;
+                break;
+            }
+            for (size_t i = 0; i < frames; i++)
+            {
+                wav_samples[i] = raw[i * channels];
+            }
+            free(raw);
+            wav_count = frames;
+            fclose(file);
+
+            if (rate != expected_rate)
+            {
+                fprintf(stderr, "host: %s a %lu Hz, se entrega como %lu Hz (sin remuestreo)\n",
+                        path, (unsigned long)rate, (unsigned long)expected_rate);
+            }
+            printf("host: audio de %s, %.1f s\n", path, (double)frames / expected_rate);
+            return true;
+        }
+        else
+        {
+            fseek(file, (long)(size + (size & 1)), SEEK_CUR);
+        }
+    }
+
+    fclose(file);
+    return false;
+}
+
+static uint64_t produced_samples(const cyhal_pdm_pcm_t *obj)
+{
+    return (now_ns() - obj->start_ns) * obj->cfg.sample_rate / 1000000000u;
+}
+
+cy_rslt_t cyhal_pdm_pcm_init(cyhal_pdm_pcm_t *obj, cyhal_gpio_t pin_data, cyhal_gpio_t pin_clk,
+                             const cyhal_clock_t *clk_source, const cyhal_pdm_pcm_cfg_t *cfg)
+{
+    const char *path = getenv("HOST_WAV_FILE");
+
+    memset(obj, 0, sizeof(*obj));
+    obj->cfg = *cfg;
+
+    if (path != NULL && wav_samples == NULL && !load_wav(path, cfg->sample_rate))
+    {
+        return CY_RSLT_HOST_ERROR;
+    }
+    if (path == NULL)
+    {
+        printf("host: sin HOST_WAV_FILE, el microfono entrega silencio\n");
+    }
+    return CY_RSLT_SUCCESS;
+}
+
+void cyhal_pdm_pcm_free(cyhal_pdm_pcm_t *obj)
+{
+    obj->running = false;
+    if (obj->dma_task != NULL)
+    {
+        vTaskDelete((TaskHandle_t)obj->dma_task);
+        obj->dma_task = NULL;
+    }
+}
+
+cy_rslt_t cyhal_pdm_pcm_start(cyhal_pdm_pcm_t *obj)
+{
+    obj->running = true;
+    obj->start_ns = now_ns();
+    obj->delivered = 0;
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cyhal_pdm_pcm_stop(cyhal_pdm_pcm_t *obj)
+{
+    obj->running = false;
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cyhal_pdm_pcm_clear(cyhal_pdm_pcm_t *obj)
+{
+    if (obj->running)
+    {
+        // Descarta lo acumulado, como vaciar la FIFO
+        obj->delivered = produced_samples(obj);
+    }
+    return CY_RSLT_SUCCESS;
+}
+
+// Copia como máximo lo que el micrófono habría producido hasta ahora
+static size_t copy_samples(cyhal_pdm_pcm_t *obj, int16_t *out, size_t max)
+{
+    size_t count = (size_t)(produced_samples(obj) - obj->delivered);
+
+    if (count > max)
+    {
+        count = max;
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        if (wav_count > 0)
+        {
+            out[i] = wav_samples[wav_position];
+            wav_position = (wav_position + 1) % wav_count;
+        }
+        else
+        {
+            out[i] = 0;
+        }
+    }
+
+    obj->delivered += count;
+    return count;
+}
+
+cy_rslt_t cyhal_pdm_pcm_read(cyhal_pdm_pcm_t *obj, void *data, size_t *length)
+{
+    taskENTER_CRITICAL();
+    *length = obj->running ? copy_samples(obj, (int16_t *)data, *length) : 0;
+    taskEXIT_CRITICAL();
+    return CY_RSLT_SUCCESS;
+}
+
+// Cada tick copia al buffer pendiente lo producido; sin lectura pendiente la
+// FIFO se llena y descarta como en el hardware (RX_OVERFLOW)
+static void dma_task(void *arg)
+{
+    cyhal_pdm_pcm_t *obj = (cyhal_pdm_pcm_t *)arg;
+
+    for (;;)
+    {
+        uint32_t events = 0;
+
+        vTaskDelay(1);
+
+        taskENTER_CRITICAL();
+        if (obj->running && obj->async_data != NULL)
+        {
+            obj->async_filled += copy_samples(obj, obj->async_data + obj->async_filled,
+                                              obj->async_length - obj->async_filled);
+            if (obj->async_filled == obj->async_length)
+            {
+                obj->async_data = NULL;
+                events |= CYHAL_PDM_PCM_ASYNC_COMPLETE;
+            }
+        }
+        else if (obj->running && produced_samples(obj) - obj->delivered > HOST_PDM_FIFO_SAMPLES)
+        {
+            obj->delivered = produced_samples(obj) - HOST_PDM_FIFO_SAMPLES;
+            events |= CYHAL_PDM_PCM_RX_OVERFLOW;
+        }
+        events &= obj->events;
+        taskEXIT_CRITICAL();
+
+        if (events != 0 && obj->callback != NULL)
+        {
+            obj->callback(obj->callback_arg, (cyhal_pdm_pcm_event_t)events);
+        }
+    }
+}
+
+cy_rslt_t cyhal_pdm_pcm_set_async_mode(cyhal_pdm_pcm_t *obj, cyhal_async_mode_t mode, uint8_t dma_priority)
+{
+    if (obj->dma_task == NULL &&
+        xTaskCreate(dma_task, "PDM_DMA", configMINIMAL_STACK_SIZE, obj, configMAX_PRIORITIES - 1,
+                    (TaskHandle_t *)&obj->dma_task) != pdPASS)
+    {
+        return CY_RSLT_HOST_ERROR;
+    }
+    return CY_RSLT_SUCCESS;
+}
+
+void cyhal_pdm_pcm_register_callback(cyhal_pdm_pcm_t *obj, cyhal_pdm_pcm_event_callback_t callback,
+                                     void *callback_arg)
+{
+    obj->callback_arg = callback_arg;
+    obj->callback = callback;
+}
+
+void cyhal_pdm_pcm_enable_event(cyhal_pdm_pcm_t *obj, cyhal_pdm_pcm_event_t event, uint8_t intr_priority,
+                                bool enable)
+{
+    obj->events = enable ? (obj->events | event) : (obj->events & ~(uint32_t)event);
+}
+
+cy_rslt_t cyhal_pdm_pcm_read_async(cyhal_pdm_pcm_t *obj, void *data, size_t length)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    taskENTER_CRITICAL();
+    if (obj->dma_task == NULL || obj->async_data != NULL)
+    {
+        result = CY_RSLT_HOST_ERROR; // Sin modo asíncrono o con otra lectura en curso
+    }
+    else
+    {
+        obj->async_data = (int16_t *)data;
+        obj->async_length = length;
+        obj->async_filled = 0;
+    }
+    taskEXIT_CRITICAL();
+    return result;
+}
+
+bool cyhal_pdm_pcm_is_pending(cyhal_pdm_pcm_t *obj)
+{
+    return obj->async_data != NULL;
+}
+
+cy_rslt_t cyhal_pdm_pcm_abort_async(cyhal_pdm_pcm_t *obj)
+{
+    taskENTER_CRITICAL();
+    obj->async_data = NULL;
+    taskEXIT_CRITICAL();
+    return CY_RSLT_SUCCESS;
+}
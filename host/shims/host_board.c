@@ -0,0 +1,268 @@
+#include "cyhal.h"
+#include "cybsp.h"
+#include "cy_retarget_io.h"
+#include <FreeRTOS.h>
+#include <task.h>
+#include <errno.h>
+#include <pthread.h>
+#include <signal.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
+
+// CMSIS EMULADO
+
+uint32_t SystemCoreClock = 1000000000u; // 1 "ciclo" = 1 ns
+CoreDebug_Type host_core_debug;
+static DWT_Type host_dwt;
+
+DWT_Type *host_dwt_sample(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    host_dwt.CYCCNT = (uint32_t)((uint64_t)now.tv_sec * 1000000000u + (uint64_t)now.tv_nsec);
+    return &host_dwt;
+}
+
+// Registros de periférico que ../source escribe por dirección absoluta
+// (pdm_frequency_fix en ia.c): se mapea una página anónima en su lugar
+static const uintptr_t mapped_registers[] = {
+    0x40A00000u, // PDM0
+};
+
+static void map_peripheral_registers(void)
+{
+    long page = sysconf(_SC_PAGESIZE);
+
+    for (size_t i = 0; i < sizeof(mapped_registers) / sizeof(mapped_registers[0]); i++)
+    {
+        void *addr = (void *)(mapped_registers[i] & ~(uintptr_t)(page - 1));
+        void *got = mmap(addr, page, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+        if (got != addr)
+        {
+            fprintf(stderr, "host: no se pudo mapear el registro 0x%08lx\n",
+                    (unsigned long)mapped_registers[i]);
+        }
+    }
+}
+
+// SRAM LIBRE EMULADA
+// heap_monitor.c reparte la SRAM libre del linker script (__HeapBase a
+// __HeapLimit) con sbrk(), como newlib en la placa. Aquí es un bloque estático
+// con su propio break; malloc() sigue usando el de glibc.
+#define HOST_FREE_SRAM_SIZE (1024 * 1024)
+#define HOST_STRINGIFY(x) #x
+#define HOST_SYMBOL_OFFSET(x) HOST_STRINGIFY(x)
+
+__attribute__((aligned(8))) uint8_t __HeapBase[HOST_FREE_SRAM_SIZE];
+extern uint8_t __HeapLimit[];
+__asm__(".globl __HeapLimit\n\t.set __HeapLimit, __HeapBase + " HOST_SYMBOL_OFFSET(HOST_FREE_SRAM_SIZE));
+
+static uint8_t *host_break = __HeapBase;
+
+void *sbrk(intptr_t increment)
+{
+    uint8_t *previous = host_break;
+
+    if (increment > __HeapLimit - host_break || increment < __HeapBase - host_break)
+    {
+        errno = ENOMEM;
+        return (void *)-1;
+    }
+    host_break += increment;
+    return previous;
+}
+
+// CICLO DE VIDA DEL PROCESO
+
+static void on_exit_report(void)
+{
+    host_gpio_report(stdout);
+}
+
+static void on_signal(int sig)
+{
+    (void)sig;
+    exit(0); // Corre los atexit: reporte de GPIO y salida limpia para valgrind
+}
+
+// HOST_RUN_SECONDS: termina la simulación sola (CI, perf, valgrind)
+static void *run_timer(void *arg)
+{
+    sleep((unsigned)(uintptr_t)arg);
+    printf("host: HOST_RUN_SECONDS cumplido\n");
+    exit(0);
+    return NULL;
+}
+
+cy_rslt_t cybsp_init(void)
+{
+    map_peripheral_registers();
+    atexit(on_exit_report);
+    signal(SIGINT, on_signal);
+    signal(SIGTERM, on_signal);
+    signal(SIGPIPE, SIG_IGN);
+
+    const char *run_seconds = getenv("HOST_RUN_SECONDS");
+    if (run_seconds != NULL && atoi(run_seconds) > 0)
+    {
+        pthread_t thread;
+        pthread_create(&thread, NULL, run_timer, (void *)(uintptr_t)atoi(run_seconds));
+        pthread_detach(thread);
+    }
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cy_retarget_io_init(cyhal_gpio_t tx, cyhal_gpio_t rx, uint32_t baudrate)
+{
+    setvbuf(stdout, NULL, _IONBF, 0);
+    return CY_RSLT_SUCCESS;
+}
+
+// GPIO EN MEMORIA
+
+#define HOST_GPIO_PINS (16 * 8)
+
+typedef struct
+{
+    bool initialized;
+    bool value;
+    uint32_t writes;
+    uint32_t edges;
+    uint64_t last_edge_ns;
+} host_gpio_t;
+
+static host_gpio_t gpios[HOST_GPIO_PINS];
+
+static host_gpio_t *gpio_slot(cyhal_gpio_t pin)
+{
+    return (pin < HOST_GPIO_PINS) ? &gpios[pin] : NULL;
+}
+
+cy_rslt_t cyhal_gpio_init(cyhal_gpio_t pin, cyhal_gpio_direction_t direction,
+                          cyhal_gpio_drive_mode_t drive_mode, bool init_val)
+{
+    host_gpio_t *gpio = gpio_slot(pin);
+
+    if (gpio == NULL || gpio->initialized)
+    {
+        return CY_RSLT_HOST_ERROR;
+    }
+    gpio->initialized = true;
+    gpio->value = init_val;
+    return CY_RSLT_SUCCESS;
+}
+
+void cyhal_gpio_free(cyhal_gpio_t pin)
+{
+    host_gpio_t *gpio = gpio_slot(pin);
+    if (gpio != NULL)
+    {
+        gpio->initialized = false;
+    }
+}
+
+void cyhal_gpio_write(cyhal_gpio_t pin, bool value)
+{
+    host_gpio_t *gpio = gpio_slot(pin);
+
+    if (gpio == NULL)
+    {
+        return;
+    }
+    gpio->writes++;
+    if (gpio->value != value)
+    {
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        gpio->last_edge_ns = (uint64_t)now.tv_sec * 1000000000u + (uint64_t)now.tv_nsec;
+        gpio->edges++;
+        gpio->value = value;
+    }
+}
+
+bool cyhal_gpio_read(cyhal_gpio_t pin)
+{
+    host_gpio_t *gpio = gpio_slot(pin);
+    return (gpio != NULL) && gpio->value;
+}
+
+void cyhal_gpio_toggle(cyhal_gpio_t pin)
+{
+    cyhal_gpio_write(pin, !cyhal_gpio_read(pin));
+}
+
+void host_gpio_report(FILE *out)
+{
+    fprintf(out, "\n=== GPIO (simulacion) ===\n");
+    for (cyhal_gpio_t pin = 0; pin < HOST_GPIO_PINS; pin++)
+    {
+        const host_gpio_t *gpio = &gpios[pin];
+        if (gpio->initialized)
+        {
+            fprintf(out, "P%lu_%lu  valor %d  escrituras %lu  flancos %lu\n",
+                    (unsigned long)CYHAL_GET_PORT(pin), (unsigned long)CYHAL_GET_PIN(pin),
+                    gpio->value, (unsigned long)gpio->writes, (unsigned long)gpio->edges);
+        }
+    }
+}
+
+// RELOJES (sin efecto)
+
+const cyhal_clock_t CYHAL_CLOCK_PLL[2] = {{.block = 1, .channel = 0}, {.block = 1, .channel = 1}};
+const cyhal_clock_t CYHAL_CLOCK_HF[2] = {{.block = 2, .channel = 0}, {.block = 2, .channel = 1}};
+
+cy_rslt_t cyhal_clock_reserve(cyhal_clock_t *clock, const cyhal_clock_t *resource)
+{
+    *clock = *resource;
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cyhal_clock_set_frequency(cyhal_clock_t *clock, uint32_t hz, const cyhal_clock_tolerance_t *tolerance)
+{
+    clock->frequency_hz = hz;
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cyhal_clock_set_enabled(cyhal_clock_t *clock, bool enabled, bool wait_for_lock)
+{
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cyhal_clock_set_source(cyhal_clock_t *clock, const cyhal_clock_t *source)
+{
+    clock->frequency_hz = source->frequency_hz;
+    return CY_RSLT_SUCCESS;
+}
+
+// HOOKS DE FREERTOS (en la placa los da la librería de Infineon)
+
+void vApplicationMallocFailedHook(void)
+{
+    fprintf(stderr, "host: pvPortMalloc sin memoria\n");
+    abort();
+}
+
+#if (tskKERNEL_VERSION_MAJOR < 11) || ((tskKERNEL_VERSION_MAJOR == 11) && (tskKERNEL_VERSION_MINOR < 1))
+void vApplicationGetIdleTaskMemory(StaticTask_t **tcb, StackType_t **stack, uint32_t *stack_words)
+{
+    static StaticTask_t idle_tcb;
+    static StackType_t idle_stack[configMINIMAL_STACK_SIZE];
+
+    *tcb = &idle_tcb;
+    *stack = idle_stack;
+    *stack_words = configMINIMAL_STACK_SIZE;
+}
+
+void vApplicationGetTimerTaskMemory(StaticTask_t **tcb, StackType_t **stack, uint32_t *stack_words)
+{
+    static StaticTask_t timer_tcb;
+    static StackType_t timer_stack[configTIMER_TASK_STACK_DEPTH];
+
+    *tcb = &timer_tcb;
+    *stack = timer_stack;
+    *stack_words = configTIMER_TASK_STACK_DEPTH;
+}
+#endif
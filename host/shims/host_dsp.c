@@ -0,0 +1,228 @@
+#include "arm_math.h"
+#include <math.h>
+
+// CMSIS-DSP escalar (ver arm_math.h)
+
+void arm_q15_to_float(const q15_t *pSrc, float32_t *pDst, uint32_t blockSize)
+{
+    for (uint32_t i = 0; i < blockSize; i++)
+    {
+        pDst[i] = (float32_t)pSrc[i] / 32768.0f;
+    }
+}
+
+void arm_scale_f32(const float32_t *pSrc, float32_t scale, float32_t *pDst, uint32_t blockSize)
+{
+    for (uint32_t i = 0; i < blockSize; i++)
+    {
+        pDst[i] = pSrc[i] * scale;
+    }
+}
+
+void arm_clip_f32(const float32_t *pSrc, float32_t *pDst, float32_t low, float32_t high, uint32_t numSamples)
+{
+    for (uint32_t i = 0; i < numSamples; i++)
+    {
+        float32_t value = pSrc[i];
+        pDst[i] = (value > high) ? high : (value < low) ? low : value;
+    }
+}
+
+// Como CMSIS: |-32768| satura a 32767 y gana el primer índice con el máximo
+void arm_absmax_q15(const q15_t *pSrc, uint32_t blockSize, q15_t *pResult, uint32_t *pIndex)
+{
+    q15_t max = 0;
+    uint32_t index = 0;
+
+    for (uint32_t i = 0; i < blockSize; i++)
+    {
+        q15_t value = (pSrc[i] > 0) ? pSrc[i] : (pSrc[i] == INT16_MIN) ? INT16_MAX : (q15_t)-pSrc[i];
+        if (value > max || i == 0)
+        {
+            max = value;
+            index = i;
+        }
+    }
+    *pResult = max;
+    *pIndex = index;
+}
+
+void arm_cmplx_mag_f32(const float32_t *pSrc, float32_t *pDst, uint32_t numSamples)
+{
+    for (uint32_t i = 0; i < numSamples; i++)
+    {
+        float32_t re = pSrc[2 * i];
+        float32_t im = pSrc[2 * i + 1];
+        pDst[i] = sqrtf(re * re + im * im);
+    }
+}
+
+// Sin redondeo, como CMSIS sin ARM_MATH_ROUNDING
+void arm_float_to_q15(const float32_t *pSrc, q15_t *pDst, uint32_t blockSize)
+{
+    for (uint32_t i = 0; i < blockSize; i++)
+    {
+        q31_t value = (q31_t)(pSrc[i] * 32768.0f);
+        pDst[i] = (q15_t)((value > INT16_MAX) ? INT16_MAX : (value < INT16_MIN) ? INT16_MIN : value);
+    }
+}
+
+void arm_scale_q15(const q15_t *pSrc, q15_t scaleFract, int8_t shift, q15_t *pDst, uint32_t blockSize)
+{
+    for (uint32_t i = 0; i < blockSize; i++)
+    {
+        q31_t value = ((q31_t)pSrc[i] * scaleFract) >> (15 - shift);
+        pDst[i] = (q15_t)((value > INT16_MAX) ? INT16_MAX : (value < INT16_MIN) ? INT16_MIN : value);
+    }
+}
+
+// Raíz de un valor Q31 en Q31; negativo da 0 y error, como CMSIS
+arm_status arm_sqrt_q31(q31_t in, q31_t *pOut)
+{
+    if (in < 0)
+    {
+        *pOut = 0;
+        return ARM_MATH_ARGUMENT_ERROR;
+    }
+    *pOut = (q31_t)sqrt((double)in * 2147483648.0);
+    return ARM_MATH_SUCCESS;
+}
+
+arm_status arm_rfft_fast_init_512_f32(arm_rfft_fast_instance_f32 *S)
+{
+    S->fftLenRFFT = 512;
+    return ARM_MATH_SUCCESS;
+}
+
+// Radix 2 complejo sobre la entrada real, en doble precisión: en la
+// simulación basta con que sea exacto, no rápido
+void arm_rfft_fast_f32(const arm_rfft_fast_instance_f32 *S, float32_t *p, float32_t *pOut, uint8_t ifftFlag)
+{
+    enum { N_MAX = 4096 };
+    static double re[N_MAX], im[N_MAX];
+    uint32_t n = S->fftLenRFFT;
+
+    for (uint32_t i = 0, j = 0; i < n; i++)
+    {
+        re[j] = p[i];
+        im[j] = 0.0;
+        // Índice con los bits invertidos
+        uint32_t bit = n >> 1;
+        for (; j & bit; bit >>= 1)
+        {
+            j ^= bit;
+        }
+        j |= bit;
+    }
+
+    for (uint32_t len = 2; len <= n; len <<= 1)
+    {
+        double angle = -2.0 * M_PI / len;
+        for (uint32_t start = 0; start < n; start += len)
+        {
+            for (uint32_t k = 0; k < len / 2; k++)
+            {
+                double wr = cos(angle * k), wi = sin(angle * k);
+                uint32_t a = start + k, b = a + len / 2;
+                double tr = re[b] * wr - im[b] * wi;
+                double ti = re[b] * wi + im[b] * wr;
+                re[b] = re[a] - tr;
+                im[b] = im[a] - ti;
+                re[a] += tr;
+                im[a] += ti;
+            }
+        }
+    }
+
+    pOut[0] = (float32_t)re[0];
+    pOut[1] = (float32_t)re[n / 2];
+    for (uint32_t k = 1; k < n / 2; k++)
+    {
+        pOut[2 * k] = (float32_t)re[k];
+        pOut[2 * k + 1] = (float32_t)im[k];
+    }
+}
+
+arm_status arm_rfft_init_512_q31(arm_rfft_instance_q31 *S, uint32_t ifftFlagR, uint32_t bitReverseFlag)
+{
+    S->fftLenReal = 512;
+    return (ifftFlagR == 0 && bitReverseFlag == 1) ? ARM_MATH_SUCCESS : ARM_MATH_ARGUMENT_ERROR;
+}
+
+static q31_t twiddle_q31(double value)
+{
+    double scaled = value * 2147483648.0;
+    return (q31_t)((scaled >= 2147483647.0) ? 2147483647.0 : scaled);
+}
+
+static q31_t mul_q31(q31_t a, q31_t b)
+{
+    return (q31_t)(((q63_t)a * b) >> 31);
+}
+
+// Como CMSIS: FFT compleja de N/2 sobre los pares (par, impar) de pSrc,
+// dividiendo por 2 en cada etapa, y luego el paso de separación, que divide
+// por 2 una vez más. pSrc se usa como espacio de trabajo.
+void arm_rfft_q31(const arm_rfft_instance_q31 *S, q31_t *pSrc, q31_t *pDst)
+{
+    uint32_t n = S->fftLenReal;
+    uint32_t half = n / 2;
+    q31_t *z = pSrc;
+
+    for (uint32_t i = 0, j = 0; i < half; i++)
+    {
+        if (i < j)
+        {
+            q31_t re = z[2 * i], im = z[2 * i + 1];
+            z[2 * i] = z[2 * j];
+            z[2 * i + 1] = z[2 * j + 1];
+            z[2 * j] = re;
+            z[2 * j + 1] = im;
+        }
+        uint32_t bit = half >> 1;
+        for (; j & bit; bit >>= 1)
+        {
+            j ^= bit;
+        }
+        j |= bit;
+    }
+
+    for (uint32_t len = 2; len <= half; len <<= 1)
+    {
+        for (uint32_t k = 0; k < len / 2; k++)
+        {
+            q31_t wr = twiddle_q31(cos(-2.0 * M_PI * k / len));
+            q31_t wi = twiddle_q31(sin(-2.0 * M_PI * k / len));
+            for (uint32_t start = 0; start < half; start += len)
+            {
+                uint32_t a = start + k, b = a + len / 2;
+                q31_t tr = (mul_q31(z[2 * b], wr) - mul_q31(z[2 * b + 1], wi)) >> 1;
+                q31_t ti = (mul_q31(z[2 * b], wi) + mul_q31(z[2 * b + 1], wr)) >> 1;
+                q31_t ar = z[2 * a] >> 1, ai = z[2 * a + 1] >> 1;
+                z[2 * b] = ar - tr;
+                z[2 * b + 1] = ai - ti;
+                z[2 * a] = ar + tr;
+                z[2 * a + 1] = ai + ti;
+            }
+        }
+    }
+
+    // X[k] = E - j W^k O con E = (Z[k] + Z*[N/2 - k]) / 2, O = (Z[k] - Z*[N/2 - k]) / 2
+    for (uint32_t k = 0; k <= half; k++)
+    {
+        uint32_t a = k % half, b = (half - k) % half;
+        q63_t er = ((q63_t)z[2 * a] + z[2 * b]) >> 1;
+        q63_t ei = ((q63_t)z[2 * a + 1] - z[2 * b + 1]) >> 1;
+        q63_t or = ((q63_t)z[2 * a] - z[2 * b]) >> 1;
+        q63_t oi = ((q63_t)z[2 * a + 1] + z[2 * b + 1]) >> 1;
+        q31_t c = twiddle_q31(cos(2.0 * M_PI * k / n));
+        q31_t s = twiddle_q31(sin(2.0 * M_PI * k / n));
+        pDst[2 * k] = (q31_t)((er + ((oi * c - or * s) >> 31)) >> 1);
+        pDst[2 * k + 1] = (q31_t)((ei - ((or * c + oi * s) >> 31)) >> 1);
+    }
+    for (uint32_t k = half + 1; k < n; k++)
+    {
+        pDst[2 * k] = pDst[2 * (n - k)];
+        pDst[2 * k + 1] = -pDst[2 * (n - k) + 1];
+    }
+}
@@ -0,0 +1,54 @@
+#include "mtb_ml.h"
+#include "mtb_ml_model.h"
+#include <stdio.h>
+#include <string.h>
+
+// Modelo simulado (ver mtb_ml_model.h)
+
+static mtb_ml_model_t model_object;
+static MTB_ML_DATA_T model_output[HOST_ML_MAX_OUTPUTS];
+static float trigger_score = 0.0f;
+
+cy_rslt_t mtb_ml_init(int npu_priority)
+{
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t mtb_ml_deinit(void)
+{
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t mtb_ml_model_init(const mtb_ml_model_bin_t *bin, const mtb_ml_model_buffer_t *buffer,
+                            mtb_ml_model_t **object)
+{
+    const char *score = getenv("HOST_ML_SCORE");
+
+    memset(&model_object, 0, sizeof(model_object));
+    snprintf(model_object.name, sizeof(model_object.name), "%s", bin->name);
+    model_object.arena = buffer->tensor_arena;
+    model_object.arena_size = buffer->tensor_arena_size;
+    model_object.output_size = HOST_ML_MAX_OUTPUTS;
+    model_object.output = model_output;
+
+    trigger_score = (score != NULL) ? (float)atof(score) : 0.0f;
+    printf("host: modelo \"%s\" simulado (%d bytes, arena %d), puntaje clase 1 = %.2f\n",
+           bin->name, bin->model_size, buffer->tensor_arena_size, trigger_score);
+
+    *object = &model_object;
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t mtb_ml_model_run(mtb_ml_model_t *object, MTB_ML_DATA_T *input)
+{
+    memset(model_output, 0, sizeof(model_output));
+    model_output[0] = 1.0f - trigger_score;
+    model_output[1] = trigger_score;
+    object->runs++;
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t mtb_ml_model_deinit(mtb_ml_model_t *object)
+{
+    return CY_RSLT_SUCCESS;
+}
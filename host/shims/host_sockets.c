@@ -0,0 +1,342 @@
+#include "cy_secure_sockets.h"
+#include "cy_wcm.h"
+#include <FreeRTOS.h>
+#include <task.h>
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#define HOST_MAX_FDS 1024
+
+// Opciones de cy_secure_sockets por descriptor; el fd del SO es siempre
+// O_NONBLOCK y el bloqueo se emula en wait_ready()
+typedef struct
+{
+    uint32_t rcv_timeout_ms;
+    uint32_t snd_timeout_ms;
+    bool nonblocking;
+} host_socket_opts_t;
+
+static host_socket_opts_t socket_opts[HOST_MAX_FDS];
+static uint16_t port_offset = 0;
+
+static inline int handle_fd(cy_socket_t handle)
+{
+    return (int)(intptr_t)handle - 1;
+}
+
+static inline cy_socket_t fd_handle(int fd)
+{
+    return (cy_socket_t)(intptr_t)(fd + 1);
+}
+
+static bool valid_fd(int fd)
+{
+    return fd >= 0 && fd < HOST_MAX_FDS;
+}
+
+static cy_rslt_t errno_result(int err)
+{
+    switch (err)
+    {
+    case EAGAIN:
+        return CY_RSLT_MODULE_SECURE_SOCKETS_TIMEOUT;
+    case ECONNRESET:
+    case EPIPE:
+    case ENOTCONN:
+        return CY_RSLT_MODULE_SECURE_SOCKETS_CLOSED;
+    case EADDRINUSE:
+        return CY_RSLT_MODULE_SECURE_SOCKETS_ADDRESS_IN_USE;
+    case ENOMEM:
+    case ENOBUFS:
+    case EMFILE:
+        return CY_RSLT_MODULE_SECURE_SOCKETS_NOMEM;
+    case EBADF:
+        return CY_RSLT_MODULE_SECURE_SOCKETS_INVALID_SOCKET;
+    default:
+        return CY_RSLT_MODULE_SECURE_SOCKETS_TCPIP_ERROR;
+    }
+}
+
+static cy_rslt_t adopt_fd(int fd, cy_socket_t *handle)
+{
+    if (!valid_fd(fd))
+    {
+        close(fd);
+        return CY_RSLT_MODULE_SECURE_SOCKETS_NOMEM;
+    }
+
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    socket_opts[fd].rcv_timeout_ms = CY_SOCKET_DEFAULT_RECEIVE_TIMEOUT;
+    socket_opts[fd].snd_timeout_ms = CY_SOCKET_DEFAULT_SEND_TIMEOUT;
+    socket_opts[fd].nonblocking = false;
+    *handle = fd_handle(fd);
+    return CY_RSLT_SUCCESS;
+}
+
+// Espera a que el fd esté listo cediendo el CPU al resto de las tareas
+static cy_rslt_t wait_ready(int fd, short events, uint32_t timeout_ms)
+{
+    TickType_t start = xTaskGetTickCount();
+
+    for (;;)
+    {
+        struct pollfd pfd = {.fd = fd, .events = events};
+        int ready = poll(&pfd, 1, 0);
+
+        if (ready > 0)
+        {
+            return CY_RSLT_SUCCESS; // Errores y cierres los reporta la operación
+        }
+        if (ready < 0 && errno != EINTR)
+        {
+            return errno_result(errno);
+        }
+        if (socket_opts[fd].nonblocking ||
+            (timeout_ms != CY_SOCKET_NEVER_TIMEOUT &&
+             (xTaskGetTickCount() - start) >= pdMS_TO_TICKS(timeout_ms)))
+        {
+            return CY_RSLT_MODULE_SECURE_SOCKETS_TIMEOUT;
+        }
+        vTaskDelay(1);
+    }
+}
+
+static void to_sockaddr(const cy_socket_sockaddr_t *in, struct sockaddr_in *out)
+{
+    memset(out, 0, sizeof(*out));
+    out->sin_family = AF_INET;
+    out->sin_port = htons((uint16_t)(in->port + port_offset));
+    out->sin_addr.s_addr = in->ip_address.ip.v4;
+}
+
+static void from_sockaddr(const struct sockaddr_in *in, cy_socket_sockaddr_t *out)
+{
+    memset(out, 0, sizeof(*out));
+    out->port = ntohs(in->sin_port);
+    out->ip_address.version = CY_SOCKET_IP_VER_V4;
+    out->ip_address.ip.v4 = in->sin_addr.s_addr;
+}
+
+// SOCKETS
+
+cy_rslt_t cy_socket_init(void)
+{
+    const char *offset = getenv("HOST_PORT_OFFSET");
+
+    port_offset = (offset != NULL) ? (uint16_t)atoi(offset) : 0;
+    if (port_offset != 0)
+    {
+        printf("host: puertos desplazados +%u (HOST_PORT_OFFSET)\n", port_offset);
+    }
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cy_socket_deinit(void)
+{
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cy_socket_create(int domain, int type, int protocol, cy_socket_t *handle)
+{
+    if (domain != CY_SOCKET_DOMAIN_AF_INET || type != CY_SOCKET_TYPE_STREAM)
+    {
+        return CY_RSLT_MODULE_SECURE_SOCKETS_PROTOCOL_NOT_SUPPORTED;
+    }
+
+    int fd = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (fd < 0)
+    {
+        return errno_result(errno);
+    }
+
+    int reuse = 1; // Reiniciar la simulación sin esperar TIME_WAIT
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    return adopt_fd(fd, handle);
+}
+
+cy_rslt_t cy_socket_setsockopt(cy_socket_t handle, int level, int optname,
+                               const void *optval, uint32_t optlen)
+{
+    int fd = handle_fd(handle);
+
+    if (!valid_fd(fd) || optval == NULL || optlen < sizeof(uint32_t))
+    {
+        return CY_RSLT_MODULE_SECURE_SOCKETS_BADARG;
+    }
+
+    uint32_t value = *(const uint32_t *)optval;
+    if (level == CY_SOCKET_SOL_SOCKET)
+    {
+        switch (optname)
+        {
+        case CY_SOCKET_SO_RCVTIMEO:
+            socket_opts[fd].rcv_timeout_ms = value;
+            return CY_RSLT_SUCCESS;
+        case CY_SOCKET_SO_SNDTIMEO:
+            socket_opts[fd].snd_timeout_ms = value;
+            return CY_RSLT_SUCCESS;
+        case CY_SOCKET_SO_NONBLOCK:
+            socket_opts[fd].nonblocking = (value != 0);
+            return CY_RSLT_SUCCESS;
+        default:
+            break;
+        }
+    }
+    else if (level == CY_SOCKET_SOL_TCP && optname == CY_SOCKET_SO_TCP_NODELAY)
+    {
+        int nodelay = (value != 0);
+        return (setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &nodelay, sizeof(nodelay)) == 0)
+                   ? CY_RSLT_SUCCESS
+                   : errno_result(errno);
+    }
+    return CY_RSLT_MODULE_SECURE_SOCKETS_BADARG;
+}
+
+cy_rslt_t cy_socket_bind(cy_socket_t handle, cy_socket_sockaddr_t *address, uint32_t address_length)
+{
+    struct sockaddr_in addr;
+
+    to_sockaddr(address, &addr);
+    if (bind(handle_fd(handle), (struct sockaddr *)&addr, sizeof(addr)) != 0)
+    {
+        fprintf(stderr, "host: bind al puerto %u: %s\n", ntohs(addr.sin_port), strerror(errno));
+        return errno_result(errno);
+    }
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cy_socket_listen(cy_socket_t handle, int backlog)
+{
+    return (listen(handle_fd(handle), backlog) == 0) ? CY_RSLT_SUCCESS : errno_result(errno);
+}
+
+cy_rslt_t cy_socket_accept(cy_socket_t handle, cy_socket_sockaddr_t *address,
+                           uint32_t *address_length, cy_socket_t *socket)
+{
+    int fd = handle_fd(handle);
+    cy_rslt_t result = wait_ready(fd, POLLIN, socket_opts[fd].rcv_timeout_ms);
+
+    if (result != CY_RSLT_SUCCESS)
+    {
+        return result;
+    }
+
+    struct sockaddr_in peer;
+    socklen_t peer_len = sizeof(peer);
+    int client_fd = accept(fd, (struct sockaddr *)&peer, &peer_len);
+    if (client_fd < 0)
+    {
+        return errno_result(errno);
+    }
+
+    from_sockaddr(&peer, address);
+    *address_length = sizeof(*address);
+    return adopt_fd(client_fd, socket);
+}
+
+cy_rslt_t cy_socket_send(cy_socket_t handle, const void *buffer, uint32_t length, int flags,
+                         uint32_t *bytes_sent)
+{
+    int fd = handle_fd(handle);
+
+    *bytes_sent = 0;
+    for (;;)
+    {
+        cy_rslt_t result = wait_ready(fd, POLLOUT, socket_opts[fd].snd_timeout_ms);
+        if (result != CY_RSLT_SUCCESS)
+        {
+            return result;
+        }
+
+        ssize_t sent = send(fd, buffer, length, MSG_NOSIGNAL);
+        if (sent >= 0)
+        {
+            *bytes_sent = (uint32_t)sent;
+            return CY_RSLT_SUCCESS;
+        }
+        if (errno != EAGAIN && errno != EINTR)
+        {
+            return errno_result(errno);
+        }
+    }
+}
+
+cy_rslt_t cy_socket_recv(cy_socket_t handle, void *buffer, uint32_t length, int flags,
+                         uint32_t *bytes_received)
+{
+    int fd = handle_fd(handle);
+
+    *bytes_received = 0;
+    for (;;)
+    {
+        cy_rslt_t result = wait_ready(fd, POLLIN, socket_opts[fd].rcv_timeout_ms);
+        if (result != CY_RSLT_SUCCESS)
+        {
+            return result;
+        }
+
+        ssize_t received = recv(fd, buffer, length, 0);
+        if (received > 0)
+        {
+            *bytes_received = (uint32_t)received;
+            return CY_RSLT_SUCCESS;
+        }
+        if (received == 0)
+        {
+            return CY_RSLT_MODULE_SECURE_SOCKETS_CLOSED;
+        }
+        if (errno != EAGAIN && errno != EINTR)
+        {
+            return errno_result(errno);
+        }
+    }
+}
+
+cy_rslt_t cy_socket_disconnect(cy_socket_t handle, uint32_t timeout)
+{
+    shutdown(handle_fd(handle), SHUT_RDWR);
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cy_socket_delete(cy_socket_t handle)
+{
+    int fd = handle_fd(handle);
+
+    if (!valid_fd(fd))
+    {
+        return CY_RSLT_MODULE_SECURE_SOCKETS_INVALID_SOCKET;
+    }
+    close(fd);
+    return CY_RSLT_SUCCESS;
+}
+
+// WI-FI SIMULADO
+
+cy_rslt_t cy_wcm_init(cy_wcm_config_t *config)
+{
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cy_wcm_connect_ap(cy_wcm_connect_params_t *connect_params, cy_wcm_ip_address_t *ip_addr)
+{
+    const char *bind_addr = getenv("HOST_BIND_ADDR");
+    struct in_addr addr = {.s_addr = htonl(INADDR_ANY)};
+
+    if (bind_addr != NULL && inet_pton(AF_INET, bind_addr, &addr) != 1)
+    {
+        fprintf(stderr, "host: HOST_BIND_ADDR invalida: %s\n", bind_addr);
+        return CY_RSLT_HOST_ERROR;
+    }
+
+    printf("host: Wi-Fi simulado (SSID \"%s\")\n", (const char *)connect_params->ap_credentials.SSID);
+    ip_addr->version = CY_WCM_IP_VER_V4;
+    ip_addr->ip.v4 = addr.s_addr;
+    return CY_RSLT_SUCCESS;
+}
@@ -0,0 +1,9 @@
+#ifndef HOST_MTB_ML_H_
+#define HOST_MTB_ML_H_
+
+#include "cyhal.h"
+
+cy_rslt_t mtb_ml_init(int npu_priority);
+cy_rslt_t mtb_ml_deinit(void);
+
+#endif /* HOST_MTB_ML_H_ */
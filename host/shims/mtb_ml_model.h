@@ -0,0 +1,47 @@
+#ifndef HOST_MTB_ML_MODEL_H_
+#define HOST_MTB_ML_MODEL_H_
+
+// Modelo simulado: TFLM no está disponible en el host, así que
+// mtb_ml_model_run no infiere. Todo el front-end de model1audio.c (ventanas,
+// FFT, mel, log) corre igual que en la placa; la salida del modelo es fija:
+// clase 0 con puntaje 1, o HOST_ML_SCORE para la clase 1 (prueba del disparo
+// por voz).
+
+#include "cyhal.h"
+
+#define MTB_ML_MODEL_NAME_LEN 32
+#define HOST_ML_MAX_OUTPUTS 16
+
+typedef float MTB_ML_DATA_T;
+
+typedef struct
+{
+    char name[MTB_ML_MODEL_NAME_LEN];
+    const uint8_t *model_bin;
+    int model_size;
+    int arena_size;
+} mtb_ml_model_bin_t;
+
+typedef struct
+{
+    uint8_t *tensor_arena;
+    int tensor_arena_size;
+} mtb_ml_model_buffer_t;
+
+typedef struct
+{
+    char name[MTB_ML_MODEL_NAME_LEN];
+    uint8_t *arena;
+    int arena_size;
+    int input_size;
+    int output_size;
+    MTB_ML_DATA_T *output;
+    uint32_t runs;
+} mtb_ml_model_t;
+
+cy_rslt_t mtb_ml_model_init(const mtb_ml_model_bin_t *bin, const mtb_ml_model_buffer_t *buffer,
+                            mtb_ml_model_t **object);
+cy_rslt_t mtb_ml_model_run(mtb_ml_model_t *object, MTB_ML_DATA_T *input);
+cy_rslt_t mtb_ml_model_deinit(mtb_ml_model_t *object);
+
+#endif /* HOST_MTB_ML_MODEL_H_ */
@@ -0,0 +1,292 @@
+/*
+ * Prueba del front-end de model1audio.c en el host (make frontend-test).
+ *
+ * Se enlaza con model1audio.c y shims/host_dsp.c, sin el kernel ni el resto
+ * del firmware. Los mtb_ml_* de abajo reemplazan a shims/host_ml.c y guardan
+ * las entradas que recibe el modelo. Comprueba:
+ *   1. IMAI_frontend_check (si la variante compilada lo define) dentro de
+ *      las tolerancias de model1audio_frontend.h.
+ *   2. Que IMAI_enqueue muestra a muestra e IMAI_enqueue_block por bloques
+ *      entreguen al modelo las mismas ventanas de features.
+ *   3. Con un modelo int8 (IMAI_MODEL_TABLES = tests/model1audio_tables_int8.h)
+ *      que cada feature sea la de la variante de referencia cuantizada como
+ *      TFLite, y que la salida int8 se decuantice. La referencia deja sus
+ *      ventanas en FRONTEND_TEST_FEATURES y la variante int8 las lee de ahí.
+ *   4. Los puntajes que devuelve IMAI_dequeue.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+#include "mtb_ml.h"
+#include "mtb_ml_model.h"
+#include "models/model1audio.h"
+#include "models/model1audio_frontend.h"
+#if defined(IMAI_MODEL_TABLES)
+#include IMAI_MODEL_TABLES
+#else
+#include "models/model1audio_tables.h"
+#endif
+
+#define TEST_SAMPLES        (16000 * 4)     // 4 s a 16 kHz
+#define TEST_BLOCK          512
+#define TEST_GAIN           10.0f
+#define TEST_WINDOWS        64
+#define TEST_FEATURES       1500
+#define TEST_SCORE_0        0.25f           // Salida fija del modelo simulado
+#define TEST_SCORE_1        0.75f
+
+#if MODEL_INPUT_INT8
+#define TEST_INPUT_BYTES    TEST_FEATURES
+#else
+#define TEST_INPUT_BYTES    (TEST_FEATURES * (int)sizeof(float))
+#endif
+
+// Modelo simulado que registra sus entradas
+
+static mtb_ml_model_t model_object;
+static MTB_ML_DATA_T model_output[HOST_ML_MAX_OUTPUTS];
+static uint8_t recorded[2][TEST_WINDOWS][TEST_FEATURES * sizeof(float)];
+static int recorded_count[2];
+static int recording;
+
+cy_rslt_t mtb_ml_init(int npu_priority)
+{
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t mtb_ml_deinit(void)
+{
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t mtb_ml_model_init(const mtb_ml_model_bin_t *bin, const mtb_ml_model_buffer_t *buffer,
+                            mtb_ml_model_t **object)
+{
+    memset(&model_object, 0, sizeof(model_object));
+    model_object.output = model_output;
+    *object = &model_object;
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t mtb_ml_model_run(mtb_ml_model_t *object, MTB_ML_DATA_T *input)
+{
+    if (recorded_count[recording] < TEST_WINDOWS)
+        memcpy(recorded[recording][recorded_count[recording]++], input, TEST_INPUT_BYTES);
+#if MODEL_OUTPUT_INT8
+    int8_t *output = (int8_t *)object->output;
+    output[0] = (int8_t)(TEST_SCORE_0 / MODEL_OUTPUT_SCALE + MODEL_OUTPUT_ZERO_POINT);
+    output[1] = (int8_t)(TEST_SCORE_1 / MODEL_OUTPUT_SCALE + MODEL_OUTPUT_ZERO_POINT);
+#else
+    object->output[0] = TEST_SCORE_0;
+    object->output[1] = TEST_SCORE_1;
+#endif
+    object->runs++;
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t mtb_ml_model_deinit(mtb_ml_model_t *object)
+{
+    return CY_RSLT_SUCCESS;
+}
+
+static __attribute__((aligned(16))) int8_t scratch[IMAI_SCRATCH_SIZE];
+static __attribute__((aligned(16))) uint8_t tflm_arena[IMAI_TFLM_ARENA_SIZE];
+static int16_t pcm[TEST_SAMPLES];
+
+static int start(void)
+{
+    IMAI_set_arena(scratch, tflm_arena);
+    return IMAI_init();
+}
+
+#if defined(IMAI_FRONTEND_CHECK)
+static uint32_t clock_ns(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint32_t)now.tv_sec * 1000000000u + (uint32_t)now.tv_nsec;
+}
+
+static int test_frontend_check(void)
+{
+    IMAI_frontend_check_t report;
+    int ret;
+
+    if (start() != IMAI_RET_SUCCESS) {
+        printf("FALLO: IMAI_init\n");
+        return 1;
+    }
+    ret = IMAI_frontend_check(clock_ns, &report);
+    printf("frontend_check %s: %d tramas, %d features fuera, error rel %.3g ln %.3g abs %.3g, "
+           "ref %lu ns, rapido %lu ns\n",
+           report.variant, report.frames, report.failed_features, report.max_rel_error,
+           report.max_log_error, report.max_abs_error,
+           (unsigned long)report.ref_cycles, (unsigned long)report.fast_cycles);
+    if (ret != 0) {
+        printf("FALLO: IMAI_frontend_check = %d\n", ret);
+        return 1;
+    }
+    return 0;
+}
+#endif
+
+// Mismo escalado que el camino por muestra de ia.c: ganancia y recorte a [-1, 1]
+static float sample_to_float(int16_t sample)
+{
+    float value = ((float)sample / 32768.0f) * TEST_GAIN;
+
+    if (value > 1.0f)
+        value = 1.0f;
+    if (value < -1.0f)
+        value = -1.0f;
+    return value;
+}
+
+static int test_block_equivalence(void)
+{
+    float scores[IMAI_DATA_OUT_COUNT];
+    int windows[2] = { 0, 0 };
+
+    srand(1);
+    for (int i = 0; i < TEST_SAMPLES; i++)
+        pcm[i] = (int16_t)(((rand() % 65536) - 32768) / (i % 7 + 1));
+
+    recording = 0;
+    if (start() != IMAI_RET_SUCCESS) {
+        printf("FALLO: IMAI_init\n");
+        return 1;
+    }
+    for (int i = 0; i < TEST_SAMPLES; i++) {
+        float sample = sample_to_float(pcm[i]);
+
+        if (IMAI_enqueue(&sample) != IMAI_RET_SUCCESS) {
+            printf("FALLO: IMAI_enqueue en la muestra %d\n", i);
+            return 1;
+        }
+        if (IMAI_dequeue(scores) == IMAI_RET_SUCCESS) {
+            windows[0]++;
+            if (scores[0] != TEST_SCORE_0 || scores[1] != TEST_SCORE_1) {
+                printf("FALLO: puntajes %g %g, se esperaba %g %g\n",
+                       scores[0], scores[1], TEST_SCORE_0, TEST_SCORE_1);
+                return 1;
+            }
+        }
+    }
+
+    recording = 1;
+    if (start() != IMAI_RET_SUCCESS) {
+        printf("FALLO: IMAI_init\n");
+        return 1;
+    }
+    for (int i = 0; i < TEST_SAMPLES; i += TEST_BLOCK) {
+        int ret = IMAI_enqueue_block(&pcm[i], TEST_BLOCK, TEST_GAIN, scores);
+
+        if (ret == IMAI_RET_SUCCESS)
+            windows[1]++;
+        else if (ret != IMAI_RET_NODATA) {
+            printf("FALLO: IMAI_enqueue_block = %d en la muestra %d\n", ret, i);
+            return 1;
+        }
+    }
+
+    printf("bloques: %d ventanas por muestra, %d por bloque, %d registradas\n",
+           windows[0], windows[1], recorded_count[1]);
+    if (recorded_count[0] == 0 || recorded_count[0] != recorded_count[1]) {
+        printf("FALLO: %d ventanas por muestra y %d por bloque\n",
+               recorded_count[0], recorded_count[1]);
+        return 1;
+    }
+    for (int w = 0; w < recorded_count[0]; w++) {
+        if (memcmp(recorded[0][w], recorded[1][w], TEST_INPUT_BYTES) != 0) {
+            printf("FALLO: la ventana %d difiere entre los dos caminos\n", w);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+#if MODEL_INPUT_INT8
+// Cuantización de la referencia como la hace TFLite: redondeo y saturación
+static int8_t quantize_reference(float feature)
+{
+    float value = roundf(feature / MODEL_INPUT_SCALE) + MODEL_INPUT_ZERO_POINT;
+
+    if (value > 127.0f)
+        value = 127.0f;
+    if (value < -128.0f)
+        value = -128.0f;
+    return (int8_t)value;
+}
+
+// Ventanas int8 registradas contra las float de la variante de referencia
+static int test_features_int8(const char *path)
+{
+    static float reference[TEST_WINDOWS][TEST_FEATURES];
+    FILE *file = fopen(path, "rb");
+    int windows = 0, saturated = 0;
+
+    if (file == NULL) {
+        printf("FALLO: no se puede leer %s (correr antes la variante de referencia)\n", path);
+        return 1;
+    }
+    windows = (int)fread(reference, sizeof(reference[0]), TEST_WINDOWS, file);
+    fclose(file);
+    if (windows != recorded_count[1]) {
+        printf("FALLO: %d ventanas de referencia y %d int8\n", windows, recorded_count[1]);
+        return 1;
+    }
+    for (int w = 0; w < windows; w++) {
+        const int8_t *quantized = (const int8_t *)recorded[1][w];
+
+        for (int i = 0; i < TEST_FEATURES; i++) {
+            if (quantized[i] != quantize_reference(reference[w][i])) {
+                printf("FALLO: ventana %d feature %d: %d, se esperaba %d (%g)\n", w, i,
+                       quantized[i], quantize_reference(reference[w][i]), reference[w][i]);
+                return 1;
+            }
+            saturated += quantized[i] == -128 || quantized[i] == 127;
+        }
+    }
+    printf("int8: %d ventanas cuantizadas como la referencia, %d features saturadas\n",
+           windows, saturated);
+    return 0;
+}
+#else
+static int save_features(const char *path)
+{
+    FILE *file = fopen(path, "wb");
+
+    if (file == NULL) {
+        printf("FALLO: no se puede escribir %s\n", path);
+        return 1;
+    }
+    for (int w = 0; w < recorded_count[1]; w++)
+        fwrite(recorded[1][w], TEST_INPUT_BYTES, 1, file);
+    fclose(file);
+    return 0;
+}
+#endif
+
+int main(void)
+{
+    const char *features = getenv("FRONTEND_TEST_FEATURES");
+    int failed = 0;
+
+#if defined(IMAI_FRONTEND_CHECK)
+    failed |= test_frontend_check();
+#endif
+    failed |= test_block_equivalence();
+    if (features != NULL && features[0] != '\0' && !failed) {
+#if MODEL_INPUT_INT8
+        failed |= test_features_int8(features);
+#else
+        failed |= save_features(features);
+#endif
+    }
+    printf("%s\n", failed ? "FALLO" : "OK");
+    return failed;
+}
@@ -0,0 +1,21 @@
+#ifndef MODEL1AUDIO_TABLES_INT8_H_
+#define MODEL1AUDIO_TABLES_INT8_H_
+
+// Tablas del front-end con un modelo cuantizado simulado (make frontend-test).
+// El modelo exportado es float32, así que el camino de features int8 de
+// model1audio_frontend.inc solo se compila con este header: las mismas tablas
+// de tools/gen_frontend_tables.py con tensores de entrada y salida int8, con
+// la escala y el punto cero que el generador leería de un .tflite cuantizado.
+
+#include "models/model1audio_tables.h"
+
+#undef MODEL_INPUT_INT8
+#undef MODEL_OUTPUT_INT8
+#define MODEL_INPUT_INT8 1
+#define MODEL_INPUT_SCALE 6.250000000e-02f
+#define MODEL_INPUT_ZERO_POINT 4
+#define MODEL_OUTPUT_INT8 1
+#define MODEL_OUTPUT_SCALE 3.906250000e-03f
+#define MODEL_OUTPUT_ZERO_POINT -128
+
+#endif /* MODEL1AUDIO_TABLES_INT8_H_ */
@@ -0,0 +1,248 @@
+#!/usr/bin/env python3
+"""
+Generador de carga sin interfaz para el servidor de control. Abre N conexiones
+concurrentes (asyncio) que simulan tableros como tcp_client.py y reproducen una
+mezcla de comandos a tasa controlada. El resultado es un JSON con caudal,
+errores y latencias p50/p99/p999:
+
+    python3 load_client.py 192.168.1.50 -c 3 -d 60 -r 5
+    python3 load_client.py 192.168.1.50 -c 3 --mix status=60,toggle=30,burst=10 -o carga.json
+
+Cada conexión tiene como máximo un comando en vuelo: el servidor trata cada
+recv como un comando y cierra cada respuesta con el prompt "> ". Las tramas
+"[COMANDO POR VOZ]" se cuentan aparte y no cierran ninguna espera.
+
+Mezcla (pesos relativos):
+  status  STATUS, como el sondeo periódico del tablero
+  toggle  n_ON / n_OFF / ALL_ON / ALL_OFF al azar
+  burst   --burst comandos seguidos sin respetar la tasa (clics repetidos)
+"""
+import argparse
+import asyncio
+import json
+import random
+import sys
+import time
+
+DEFAULT_PORT = 599
+PROMPT = b"> "
+VOICE_TAG = b"[COMANDO POR VOZ]"
+TOGGLES = ["1_ON", "1_OFF", "2_ON", "2_OFF", "3_ON", "3_OFF", "4_ON", "4_OFF", "ALL_ON", "ALL_OFF"]
+
+# Respuestas que el servidor usa para informar fallos (tcp_server.c, control.c)
+ERROR_REPLIES = {
+    b"SERVIDOR OCUPADO": "busy",
+    b"COMANDO NO RECONOCIDO": "unknown_command",
+}
+REJECT_REPLIES = (b"Servidor lleno", b"Servidor sin memoria")
+
+
+def percentiles(samples):
+    if not samples:
+        return {"n": 0}
+    samples = sorted(samples)
+
+    def pick(fraction):
+        return round(samples[min(len(samples) - 1, int(fraction * len(samples)))], 3)
+
+    return {
+        "n": len(samples),
+        "min_ms": round(samples[0], 3),
+        "p50_ms": pick(0.50),
+        "p90_ms": pick(0.90),
+        "p99_ms": pick(0.99),
+        "p999_ms": pick(0.999),
+        "max_ms": round(samples[-1], 3),
+        "mean_ms": round(sum(samples) / len(samples), 3),
+    }
+
+
+class Stats:
+    def __init__(self):
+        self.connections = {"ok": 0, "rejected": 0, "failed": 0, "dropped": 0}
+        self.sent = 0
+        self.ok = 0
+        self.errors = {}
+        self.voice = 0
+        self.latency = {}       # tipo de operación -> [ms]
+
+    def error(self, kind):
+        self.errors[kind] = self.errors.get(kind, 0) + 1
+
+
+class Dashboard:
+    """Una conexión: espera el prompt de bienvenida y luego reproduce la mezcla."""
+
+    def __init__(self, index, args, stats, rng):
+        self.index = index
+        self.args = args
+        self.stats = stats
+        self.rng = rng
+        self.reader = None
+        self.writer = None
+        self.pending = b""
+
+    async def read_reply(self):
+        """Bloque de texto hasta el próximo prompt, saltando los broadcasts por voz."""
+        while True:
+            end = self.pending.find(PROMPT)
+            if end >= 0:
+                block = self.pending[:end]
+                self.pending = self.pending[end + len(PROMPT):]
+                if VOICE_TAG in block:
+                    self.stats.voice += 1
+                    continue
+                return block
+            chunk = await self.reader.read(4096)
+            if not chunk:
+                raise ConnectionResetError("conexion cerrada por el servidor")
+            self.pending += chunk
+
+    async def connect(self):
+        try:
+            self.reader, self.writer = await asyncio.wait_for(
+                asyncio.open_connection(self.args.host, self.args.port), self.args.timeout)
+            welcome = await asyncio.wait_for(self.read_reply(), self.args.timeout)
+        except (OSError, asyncio.TimeoutError) as exc:
+            if self.pending.startswith(REJECT_REPLIES):
+                self.stats.connections["rejected"] += 1
+            else:
+                self.stats.connections["failed"] += 1
+                print("conexion %d: %s" % (self.index, exc or type(exc).__name__), file=sys.stderr)
+            return False
+        if welcome.startswith(REJECT_REPLIES):
+            self.stats.connections["rejected"] += 1
+            return False
+        self.stats.connections["ok"] += 1
+        return True
+
+    async def command(self, op, text):
+        self.pending = b""      # Una respuesta tardía no se atribuye al próximo comando
+        start = time.perf_counter()
+        self.writer.write(text.encode("ascii") + b"\n")
+        await self.writer.drain()
+        self.stats.sent += 1
+        try:
+            reply = await asyncio.wait_for(self.read_reply(), self.args.timeout)
+        except asyncio.TimeoutError:
+            self.stats.error("timeout")
+            return
+        elapsed_ms = (time.perf_counter() - start) * 1000.0
+
+        for marker, kind in ERROR_REPLIES.items():
+            if marker in reply:
+                self.stats.error(kind)
+                return
+        self.stats.ok += 1
+        self.stats.latency.setdefault(op, []).append(elapsed_ms)
+
+    async def run(self, deadline, weights):
+        if not await self.connect():
+            return
+        period = 1.0 / self.args.rate if self.args.rate > 0 else 0.0
+        next_send = time.perf_counter() + self.rng.random() * period  # Desfasar conexiones
+        ops = list(weights)
+        try:
+            while time.perf_counter() < deadline:
+                delay = next_send - time.perf_counter()
+                if delay > 0:
+                    await asyncio.sleep(delay)
+                next_send += period
+
+                op = self.rng.choices(ops, weights=[weights[o] for o in ops])[0]
+                if op == "status":
+                    await self.command("status", "STATUS")
+                elif op == "toggle":
+                    await self.command("toggle", self.rng.choice(TOGGLES))
+                else:
+                    for _ in range(self.args.burst):
+                        await self.command("burst", self.rng.choice(TOGGLES))
+
+                # Sin acumular atraso si el servidor no alcanza la tasa pedida
+                next_send = max(next_send, time.perf_counter())
+        except (ConnectionError, OSError) as exc:
+            self.stats.connections["dropped"] += 1
+            self.stats.error("disconnect")
+            print("conexion %d: %s" % (self.index, exc), file=sys.stderr)
+        finally:
+            self.writer.close()
+
+
+def parse_mix(text):
+    weights = {}
+    for item in text.split(","):
+        name, _, weight = item.partition("=")
+        name = name.strip()
+        if name not in ("status", "toggle", "burst"):
+            raise argparse.ArgumentTypeError("operacion desconocida: %s" % name)
+        weights[name] = float(weight or 1)
+    return weights
+
+
+async def run_load(args):
+    stats = Stats()
+    deadline = time.perf_counter() + args.duration
+    rng = random.Random(args.seed)
+    dashboards = [Dashboard(i, args, stats, random.Random(rng.random())) for i in range(args.connections)]
+
+    start = time.perf_counter()
+    tasks = []
+    for dashboard in dashboards:
+        tasks.append(asyncio.ensure_future(dashboard.run(deadline, args.mix)))
+        if args.ramp > 0:
+            await asyncio.sleep(args.ramp / args.connections)
+    await asyncio.gather(*tasks)
+    elapsed = time.perf_counter() - start
+
+    errors = sum(stats.errors.values())
+    all_latency = [ms for samples in stats.latency.values() for ms in samples]
+    return {
+        "host": args.host,
+        "port": args.port,
+        "connections": args.connections,
+        "rate_per_connection": args.rate,
+        "mix": args.mix,
+        "duration_s": round(elapsed, 3),
+        "connection_results": stats.connections,
+        "commands": {
+            "sent": stats.sent,
+            "ok": stats.ok,
+            "errors": stats.errors,
+            "error_rate": round(errors / stats.sent, 6) if stats.sent else 0.0,
+            "throughput_per_s": round(stats.ok / elapsed, 3) if elapsed > 0 else 0.0,
+        },
+        "voice_broadcasts": stats.voice,
+        "latency": percentiles(all_latency),
+        "latency_by_op": {op: percentiles(samples) for op, samples in stats.latency.items()},
+    }
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Carga concurrente sobre el servidor de control")
+    parser.add_argument("host", help="IP del servidor")
+    parser.add_argument("-p", "--port", type=int, default=DEFAULT_PORT)
+    parser.add_argument("-c", "--connections", type=int, default=3, help="tableros simulados")
+    parser.add_argument("-d", "--duration", type=float, default=30.0, help="segundos de carga")
+    parser.add_argument("-r", "--rate", type=float, default=2.0, help="operaciones/s por conexion (0 = sin pausa)")
+    parser.add_argument("--mix", type=parse_mix, default=parse_mix("status=70,toggle=25,burst=5"))
+    parser.add_argument("--burst", type=int, default=5, help="comandos por rafaga")
+    parser.add_argument("--ramp", type=float, default=1.0, help="segundos para abrir todas las conexiones")
+    parser.add_argument("--timeout", type=float, default=2.0, help="espera maxima por respuesta")
+    parser.add_argument("--seed", type=int, default=None)
+    parser.add_argument("-o", "--output", help="archivo JSON (por defecto stdout)")
+    args = parser.parse_args()
+
+    report = asyncio.run(run_load(args))
+    text = json.dumps(report, indent=2)
+    if args.output:
+        with open(args.output, "w") as f:
+            f.write(text + "\n")
+    else:
+        print(text)
+
+    ok = report["connection_results"]["failed"] == 0 and report["commands"]["sent"] > 0
+    sys.exit(0 if ok else 1)
+
+
+if __name__ == "__main__":
+    main()
@@ -22,6 +22,7 @@
 #define configUSE_16_BIT_TICKS                  0
 #define configIDLE_SHOULD_YIELD                 1
 #define configUSE_TASK_NOTIFICATIONS            1
+#define configTASK_NOTIFICATION_ARRAY_ENTRIES   2   /* 1: recepción de clientes (tcp_server.c) */
 #define configUSE_MUTEXES                       1
 #define configUSE_RECURSIVE_MUTEXES             1
 #define configUSE_COUNTING_SEMAPHORES           1
@@ -34,7 +35,7 @@
 /* Memory allocation related definitions. */
 #define configSUPPORT_STATIC_ALLOCATION         1
 #define configSUPPORT_DYNAMIC_ALLOCATION        1
-#define configTOTAL_HEAP_SIZE                   10240
+#define configTOTAL_HEAP_SIZE                   10240   /* Sin efecto con heap_5: ver heap_monitor.c */
 #define configAPPLICATION_ALLOCATED_HEAP        0
 
 /* Hook function related definitions. */
@@ -115,7 +116,7 @@ to exclude the API function. */
 #define INCLUDE_vTaskDelay                      1
 #define INCLUDE_xTaskGetSchedulerState          1
 #define INCLUDE_xTaskGetCurrentTaskHandle       1
-#define INCLUDE_uxTaskGetStackHighWaterMark     0
+#define INCLUDE_uxTaskGetStackHighWaterMark     1
 #define INCLUDE_xTaskGetIdleTaskHandle          0
 #define INCLUDE_eTaskGetState                   0
 #define INCLUDE_xEventGroupSetBitFromISR        1
@@ -146,7 +147,17 @@ standard names - or at least those used in the unmodified vector table. */
 #define HEAP_ALLOCATION_TYPE5                   (5)     /* heap_5.c*/
 #define NO_HEAP_ALLOCATION                      (0)
 
-#define configHEAP_ALLOCATION_SCHEME            (HEAP_ALLOCATION_TYPE3)
+/* heap_5: regiones definidas en heap_monitor_init() antes de crear objetos del kernel */
+#define configHEAP_ALLOCATION_SCHEME            (HEAP_ALLOCATION_TYPE5)
+
+/* Contador de asignaciones en régimen permanente (heap_monitor.c) */
+extern void heap_monitor_on_malloc( void *ptr, size_t size );
+#define traceMALLOC( pvAddress, uiSize )        heap_monitor_on_malloc( ( pvAddress ), ( uiSize ) )
+
+/* Registrador de trazas del kernel (trace_recorder.c) */
+#if defined(APP_TRACE_RECORDER)
+#include "trace_recorder_hooks.h"
+#endif
 
 /* Check if the ModusToolbox Device Configurator Power personality parameter
  * "System Idle Power Mode" is set to either "CPU Sleep" or "System Deep Sleep".
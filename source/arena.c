@@ -0,0 +1,142 @@
+#include <stdbool.h>
+#include "arena.h"
+#include "report.h"
+
+#define ARENA_MAX_REGIONS 16
+
+static uint32_t align_up(uint32_t value)
+{
+    return (value + ARENA_ALIGN - 1) & ~(uint32_t)(ARENA_ALIGN - 1);
+}
+
+// true si la región cabe en offset sin pisar a otra ya ubicada que esté viva
+// en alguna de sus fases
+static bool fits(const arena_t *arena, const bool *placed, int index, uint32_t offset)
+{
+    const arena_region_t *region = &arena->regions[index];
+
+    for (int i = 0; i < arena->count; i++)
+    {
+        const arena_region_t *other = &arena->regions[i];
+
+        if (i == index || !placed[i] || (other->phases & region->phases) == 0)
+        {
+            continue;
+        }
+        if (offset < (uint32_t)other->offset + other->size &&
+            (uint32_t)other->offset < offset + region->size)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool arena_plan(arena_t *arena)
+{
+    bool placed[ARENA_MAX_REGIONS];
+    int order[ARENA_MAX_REGIONS];
+    int pending = 0;
+
+    if (arena->count > ARENA_MAX_REGIONS)
+    {
+        return false;
+    }
+
+    arena->peak = 0;
+    arena->total = 0;
+    for (int i = 0; i < arena->count; i++)
+    {
+        arena->total += align_up(arena->regions[i].size);
+        placed[i] = arena->regions[i].offset != ARENA_UNPLACED;
+    }
+
+    // Las fijas no se mueven: solo se comprueba que no choquen entre sí
+    for (int i = 0; i < arena->count; i++)
+    {
+        if (placed[i] && !fits(arena, placed, i, (uint32_t)arena->regions[i].offset))
+        {
+            return false;
+        }
+    }
+
+    // El resto, de mayor a menor tamaño (inserción: son pocas)
+    for (int i = 0; i < arena->count; i++)
+    {
+        if (placed[i])
+        {
+            continue;
+        }
+        int j = pending++;
+        while (j > 0 && arena->regions[order[j - 1]].size < arena->regions[i].size)
+        {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = i;
+    }
+
+    // Candidatos: el inicio del pool y el final de cada región que convive con
+    // la que se ubica; gana el menor donde cabe
+    for (int k = 0; k < pending; k++)
+    {
+        int index = order[k];
+        uint32_t best = fits(arena, placed, index, 0) ? 0 : UINT32_MAX;
+
+        for (int i = 0; i < arena->count; i++)
+        {
+            const arena_region_t *other = &arena->regions[i];
+
+            if (!placed[i] || (other->phases & arena->regions[index].phases) == 0)
+            {
+                continue;
+            }
+            uint32_t candidate = align_up((uint32_t)other->offset + other->size);
+            if (candidate < best && fits(arena, placed, index, candidate))
+            {
+                best = candidate;
+            }
+        }
+        arena->regions[index].offset = (int32_t)best;
+        placed[index] = true;
+    }
+
+    for (int i = 0; i < arena->count; i++)
+    {
+        uint32_t end = (uint32_t)arena->regions[i].offset + arena->regions[i].size;
+        if (end > arena->peak)
+        {
+            arena->peak = end;
+        }
+    }
+    return arena->peak <= arena->pool_size;
+}
+
+int arena_report(const arena_t *arena, char *buffer, size_t buffer_size)
+{
+    int len = report_append(buffer, buffer_size, 0,
+                            "=== ARENA (bytes) ===\n"
+                            "Pool: %lu  Pico: %lu  Sin solapar: %lu\n"
+                            "REGION              OFFSET   BYTES  FASES\n",
+                            (unsigned long)arena->pool_size, (unsigned long)arena->peak,
+                            (unsigned long)arena->total);
+
+    for (int i = 0; i < arena->count; i++)
+    {
+        const arena_region_t *region = &arena->regions[i];
+        const char *separator = "";
+
+        len = report_append(buffer, buffer_size, len, "%-18s %7ld %7lu  ", region->name,
+                            (long)region->offset, (unsigned long)region->size);
+        for (int phase = 0; phase < arena->phase_count; phase++)
+        {
+            if (region->phases & ARENA_PHASE(phase))
+            {
+                len = report_append(buffer, buffer_size, len, "%s%s", separator, arena->phase_names[phase]);
+                separator = ",";
+            }
+        }
+        len = report_append(buffer, buffer_size, len, "\n");
+    }
+    return len;
+}
@@ -0,0 +1,50 @@
+#ifndef ARENA_H_
+#define ARENA_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Planificador de memoria por tiempo de vida: varias regiones comparten un
+// pool estático y dos regiones solo pueden solaparse si no están vivas en
+// ninguna fase común. Cada región declara sus fases como máscara de bits
+// (ARENA_PHASE); el plan se arma una vez al arrancar, antes de usar el pool.
+
+#define ARENA_ALIGN 16      // Alineación de cada región (tensores TFLM, DMA)
+#define ARENA_UNPLACED (-1) // offset de una región que ubica el planificador
+#define ARENA_PHASE(n) (1u << (n))
+
+typedef struct
+{
+    const char *name;
+    uint32_t size;
+    uint32_t phases; // Máscara de ARENA_PHASE() en las que está viva
+    int32_t offset;  // Fija si >= 0 (p. ej. cabeza y cola de la arena TFLM)
+} arena_region_t;
+
+typedef struct
+{
+    uint8_t *pool; // Alineado a ARENA_ALIGN
+    uint32_t pool_size;
+    arena_region_t *regions;
+    int count;
+    const char *const *phase_names; // Para el reporte, una por bit
+    int phase_count;
+    uint32_t peak;  // Fin de la región más alta del plan
+    uint32_t total; // Suma de los tamaños: lo que ocuparían sin solapar
+} arena_t;
+
+// Ubica las regiones no fijas de mayor a menor en el primer offset alineado
+// donde no pisan a ninguna región ya ubicada con fases en común. Devuelve
+// false si dos regiones fijas chocan o si el pico no entra en el pool.
+bool arena_plan(arena_t *arena);
+
+static inline void *arena_ptr(const arena_t *arena, int region)
+{
+    return arena->pool + arena->regions[region].offset;
+}
+
+// Pool, pico y suma sin solapar, y la tabla de regiones con sus fases
+int arena_report(const arena_t *arena, char *buffer, size_t buffer_size);
+
+#endif /* ARENA_H_ */
@@ -0,0 +1,100 @@
+#include <string.h>
+#include "command.h"
+#include "report.h"
+
+typedef struct
+{
+    const char *cmd;
+    uint8_t cmd_len;
+    command_desc_t desc;
+} command_entry_t;
+
+// Tabla de lookup optimizada - ordenada por frecuencia de uso
+static const command_entry_t command_table[] = {
+    {"STATUS", 6, {COMMAND_OP_STATUS, COMMAND_ALL_OUTPUTS, 0}}, // Comando más común
+    {"ALL_ON", 6, {COMMAND_OP_SET, COMMAND_ALL_OUTPUTS, 1}},    // Segundo más común
+    {"ALL_OFF", 7, {COMMAND_OP_SET, COMMAND_ALL_OUTPUTS, 0}},
+    {"1_ON", 4, {COMMAND_OP_SET, 0x01, 1}},
+    {"1_OFF", 5, {COMMAND_OP_SET, 0x01, 0}},
+    {"2_ON", 4, {COMMAND_OP_SET, 0x02, 1}},
+    {"2_OFF", 5, {COMMAND_OP_SET, 0x02, 0}},
+    {"3_ON", 4, {COMMAND_OP_SET, 0x04, 1}},
+    {"3_OFF", 5, {COMMAND_OP_SET, 0x04, 0}},
+    {"4_ON", 4, {COMMAND_OP_SET, 0x08, 1}},
+    {"4_OFF", 5, {COMMAND_OP_SET, 0x08, 0}}};
+
+#define COMMAND_TABLE_SIZE (sizeof(command_table) / sizeof(command_entry_t))
+_Static_assert(COMMAND_TABLE_SIZE == COMMAND_COUNT, "COMMAND_COUNT no coincide con la tabla");
+
+bool command_parse(const char *token, size_t len, command_desc_t *out)
+{
+    // Búsqueda lineal optimizada (mejor para tabla pequeña)
+    for (int i = 0; i < COMMAND_TABLE_SIZE; i++)
+    {
+        if (len == command_table[i].cmd_len &&
+            memcmp(token, command_table[i].cmd, len) == 0)
+        {
+            *out = command_table[i].desc;
+            return true;
+        }
+    }
+
+    out->opcode = COMMAND_OP_UNKNOWN;
+    out->mask = 0;
+    out->value = 0;
+    return false;
+}
+
+int command_index(const command_desc_t *cmd)
+{
+    for (int i = 0; i < COMMAND_TABLE_SIZE; i++)
+    {
+        const command_desc_t *desc = &command_table[i].desc;
+        if (desc->opcode == cmd->opcode && desc->mask == cmd->mask && desc->value == cmd->value)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+const char *command_name(int index)
+{
+    return (index >= 0 && index < COMMAND_TABLE_SIZE) ? command_table[index].cmd : "?";
+}
+
+int command_format_response(const command_desc_t *cmd, uint8_t outputs,
+                            char *buffer, size_t buffer_size, int len)
+{
+    switch (cmd->opcode)
+    {
+    case COMMAND_OP_STATUS:
+        return report_append(buffer, buffer_size, len, "S1:%s S2:%s S3:%s S4:%s",
+                             (outputs & 0x01) ? "ON" : "OFF",
+                             (outputs & 0x02) ? "ON" : "OFF",
+                             (outputs & 0x04) ? "ON" : "OFF",
+                             (outputs & 0x08) ? "ON" : "OFF");
+
+    case COMMAND_OP_SET:
+        if (cmd->mask == COMMAND_ALL_OUTPUTS)
+        {
+            return report_append(buffer, buffer_size, len, "TODAS LAS SALIDAS: %s",
+                                 cmd->value ? "ON" : "OFF");
+        }
+        else
+        {
+            // Determinar qué salida fue afectada
+            int output_num = 0;
+            uint8_t mask = cmd->mask;
+            while (mask >>= 1)
+                output_num++; // Encuentra el bit activo
+
+            return report_append(buffer, buffer_size, len, "SALIDA %d: %s",
+                                 output_num + 1, cmd->value ? "ON" : "OFF");
+        }
+
+    case COMMAND_OP_UNKNOWN:
+    default:
+        return report_append(buffer, buffer_size, len, "COMANDO NO RECONOCIDO");
+    }
+}
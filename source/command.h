@@ -0,0 +1,42 @@
+#ifndef COMMAND_H_
+#define COMMAND_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Comandos de control ya parseados. Es lo que viaja por las colas entre el
+// servidor, la IA y control en lugar del texto: el servidor reconoce el token
+// donde llega y el texto de la respuesta se arma solo al enviarla.
+
+typedef enum
+{
+    COMMAND_OP_UNKNOWN = 0, // Token que no está en la tabla
+    COMMAND_OP_STATUS,
+    COMMAND_OP_SET          // Salidas de mask a value
+} command_op_t;
+
+typedef struct
+{
+    uint8_t opcode; // command_op_t
+    uint8_t mask;   // Salidas afectadas, bit 0 = salida 1
+    uint8_t value;  // 1 = ON
+} command_desc_t;
+
+#define COMMAND_ALL_OUTPUTS 0x0F
+#define COMMAND_TOKEN_MAX 15 // Cabe el token más largo (control y diagnóstico)
+#define COMMAND_COUNT 11     // Entradas de la tabla de command.c
+
+// Token ya recortado -> descriptor; false (y COMMAND_OP_UNKNOWN) si no existe
+bool command_parse(const char *token, size_t len, command_desc_t *out);
+
+// Entrada de la tabla con ese descriptor (estadísticas de control), -1 si no hay
+int command_index(const command_desc_t *cmd);
+const char *command_name(int index);
+
+// Texto de la respuesta a cmd; outputs son las salidas encendidas después de
+// ejecutarlo (bit 0 = salida 1). Devuelve la nueva longitud, como report_append.
+int command_format_response(const command_desc_t *cmd, uint8_t outputs,
+                            char *buffer, size_t buffer_size, int len);
+
+#endif /* COMMAND_H_ */
@@ -7,12 +7,45 @@
 #define BUFFER_SIZE 256
 #define MAX_RETRIES 5
 #define MAX_CLIENTS 3
-#define CLIENT_TASK_STACK_SIZE (1024 * 4)
+#define BROADCAST_RING_SIZE 8 // Comandos por voz pendientes de entregar por cliente
+#define CLIENT_TASK_STACK_SIZE (1024 * 4) // En palabras (StackType_t, 4 bytes)
 #define CLIENT_TASK_PRIORITY 2
+#define TRANSPORT_MAX_CONNECTIONS (MAX_CLIENTS + 2 + 8) // Clientes, escucha, un rechazo en curso y servicios de prueba
 #define SERVER_RECOVERY_DELAY_MS 5000
 #define CLIENT_TIMEOUT_MS 80000  // 80 segundos timeout por cliente
 #define FAST_QUEUE_TIMEOUT   pdMS_TO_TICKS(25)   // Para operaciones críticas
 #define NORMAL_QUEUE_TIMEOUT pdMS_TO_TICKS(100)  // Para operaciones normales
+#define MESSAGE_QUEUE_LENGTH 20 // Profundidad de las colas entre tareas
+#define REPORT_BUFFER_SIZE 2048 // Respuestas de comandos de diagnostico
+#define QUEUE_MONITOR_MAX_QUEUES 4 // Colas instrumentadas (queue_monitor.c)
+// Tareas (pilas en palabras de StackType_t = 4 bytes, no en bytes)
+#define TCP_SERVER_TASK_STACK_SIZE (1024 * 5)
+#define IA_TASK_STACK_SIZE (1024 * 50)
+#define CONTROL_TASK_STACK_SIZE (1024 * 2)
+// Monitoreo de pilas
+#define STACK_MONITOR_PERIOD_MS 1000 // Muestreo de tareas de larga vida
+#define STACK_MONITOR_MARGIN_PCT 25  // Margen sobre el pico observado
+// Heap del kernel (heap_5): las pilas de las tareas salen de aquí. Ocupa la
+// SRAM libre del linker (__HeapBase a __HeapLimit) menos la reserva de newlib.
+#define HEAP_NEWLIB_RESERVE (128 * 1024)   // malloc() de WHD, lwIP, mbedTLS y printf
+#if defined(APP_ZERO_HEAP)
+#define HEAP_REGION_MIN_SIZE (32 * 1024)   // Pilas y colas propias son estáticas
+#else
+#define HEAP_REGION_MIN_SIZE (256 * 1024)  // Pila de IA (200 KB), clientes y colas
+#endif
+#define HEAP_RESERVE_BYTES (8 * 1024)      // Libre mínimo tras admitir un cliente
+#define CLIENT_HEAP_OVERHEAD_BYTES 2048    // TCB, mailboxes y semáforos del socket
+// Registrador de trazas (APP_TRACE_RECORDER)
+#define TRACE_BUFFER_EVENTS 4096 // 8 bytes por evento (32 KB), potencia de 2
+// Servicios de prueba de red (APP_BENCH_SERVICES)
+#define BENCH_ECHO_PORT 7        // RFC 862
+#define BENCH_DISCARD_PORT 9     // RFC 863
+#define BENCH_CHARGEN_PORT 19    // RFC 864
+#define BENCH_PINGPONG_PORT 5999 // Tramas de 32 bytes con tiempo en placa
+#define BENCH_BUFFER_SIZE 1460   // Un MSS por recv/send
+#define BENCH_IDLE_TIMEOUT_MS 10000
+#define BENCH_TASK_STACK_SIZE 1024 // En palabras
+#define BENCH_TASK_PRIORITY 1      // Por debajo de clientes, IA y control
 // Pines
 /* PDM/PCM Pins */
 #define PDM_DATA P10_5
@@ -29,8 +62,17 @@
 #define MICROPHONE_GAIN 20
 #define DIGITAL_BOOST_FACTOR 10.0f
 #define AUIDO_BITS_PER_SAMPLE 16
-#define AUDIO_BUFFER_SIZE 512
+#define AUDIO_BUFFER_SIZE 512 // Muestras por bloque del DMA (32 ms a 16 kHz)
+#define AUDIO_BLOCK_US ((AUDIO_BUFFER_SIZE * 1000000UL) / SAMPLE_RATE_HZ)
+#define AUDIO_CAPTURE_TIMEOUT_MS 200 // Sin bloques del DMA en este tiempo se relanza la captura
+#define PDM_ISR_PRIORITY 7 // La más baja; el callback usa la API FromISR (MAX_SYSCALL 0x3F)
 #define SAMPLE_NORMALIZE(sample) (((float)(sample)) / (float)(1 << (AUIDO_BITS_PER_SAMPLE - 1)))
+#define AUDIO_SAMPLE_GAIN (SAMPLE_NORMALIZE(1) * DIGITAL_BOOST_FACTOR) // Normalización y boost en un producto
+// Arena de la tarea IA (ia.c). Con APP_SHARED_ARENA el scratch del front-end
+// va dentro de los primeros TFLM_ARENA_HEAD_BYTES de la arena de TFLM, que
+// solo tienen tensores no persistentes (TFLM asigna lo persistente desde el
+// final); IMAI_arena_check lo comprueba al arrancar.
+#define TFLM_ARENA_HEAD_BYTES 8208
 // Disparador ML
 #define ML_TRIGGER_THRESHOLD 0.90f
 #define ML_TRIGGER_LABEL_INDEX 1
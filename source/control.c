@@ -10,33 +10,10 @@
 #include "control.h"
 #include "config.h"
 #include "types.h"
-
-// Estructura optimizada para comandos
-typedef struct
-{
-    const char *cmd;
-    uint8_t cmd_len;
-    uint8_t output_mask; // Bitmask para múltiples salidas
-    bool state;
-    bool is_status;
-    bool is_multi_output;
-} command_lookup_t;
-
-// Tabla de lookup optimizada - ordenada por frecuencia de uso
-static const command_lookup_t command_table[] = {
-    {"STATUS", 6, 0x0F, false, true, false}, // Comando más común
-    {"ALL_ON", 6, 0x0F, true, false, true},  // Segundo más común
-    {"ALL_OFF", 7, 0x0F, false, false, true},
-    {"1_ON", 4, 0x01, true, false, false},
-    {"1_OFF", 5, 0x01, false, false, false},
-    {"2_ON", 4, 0x02, true, false, false},
-    {"2_OFF", 5, 0x02, false, false, false},
-    {"3_ON", 4, 0x04, true, false, false},
-    {"3_OFF", 5, 0x04, false, false, false},
-    {"4_ON", 4, 0x08, true, false, false},
-    {"4_OFF", 5, 0x08, false, false, false}};
-
-#define COMMAND_TABLE_SIZE (sizeof(command_table) / sizeof(command_lookup_t))
+#include "queue_monitor.h"
+#include "latency_monitor.h"
+#include "command.h"
+#include "tcp_server.h"
 
 typedef struct
 {
@@ -49,23 +26,7 @@ typedef struct
 static gpio_output_t outputs[NUM_OUTPUTS];
 static const cyhal_gpio_t OUTPUT_PINS[NUM_OUTPUTS] = {OUT1, OUT2, OUT3, OUT4};
 static task_params_t *control_params;
-static uint32_t command_stats[COMMAND_TABLE_SIZE] = {0}; // Estadísticas de uso
-
-// Función de búsqueda binaria optimizada
-static const command_lookup_t *find_command_fast(const char *cmd, size_t len)
-{
-    // Búsqueda lineal optimizada (mejor para tabla pequeña)
-    for (int i = 0; i < COMMAND_TABLE_SIZE; i++)
-    {
-        if (len == command_table[i].cmd_len &&
-            memcmp(cmd, command_table[i].cmd, len) == 0)
-        {
-            command_stats[i]++; // Actualizar estadísticas
-            return &command_table[i];
-        }
-    }
-    return NULL;
-}
+static uint32_t command_stats[COMMAND_COUNT] = {0}; // Estadísticas de uso
 
 // Función optimizada para aplicar comandos usando bitmask
 static void apply_command_bitmask(uint8_t output_mask, bool state)
@@ -86,36 +47,19 @@ static void apply_command_bitmask(uint8_t output_mask, bool state)
     }
 }
 
-// Función optimizada para generar respuesta de estado
-static void generate_status_response(char *buffer, size_t buffer_size)
+// Salidas encendidas, bit 0 = salida 1 (command_format_response)
+static uint8_t outputs_bitmap(void)
 {
-    snprintf(buffer, buffer_size, "S1:%s S2:%s S3:%s S4:%s",
-             outputs[0].state ? "ON" : "OFF",
-             outputs[1].state ? "ON" : "OFF",
-             outputs[2].state ? "ON" : "OFF",
-             outputs[3].state ? "ON" : "OFF");
-}
+    uint8_t bitmap = 0;
 
-// Función optimizada para generar respuesta de comando
-static void generate_command_response(const command_lookup_t *cmd_info, char *buffer, size_t buffer_size)
-{
-    if (cmd_info->is_multi_output)
-    {
-        snprintf(buffer, buffer_size, "TODAS LAS SALIDAS: %s",
-                 cmd_info->state ? "ON" : "OFF");
-    }
-    else
+    for (int i = 0; i < NUM_OUTPUTS; i++)
     {
-        // Determinar qué salida fue afectada
-        int output_num = 0;
-        uint8_t mask = cmd_info->output_mask;
-        while (mask >>= 1)
-            output_num++; // Encuentra el bit activo
-        output_num++;     // Ajustar a base 1
-
-        snprintf(buffer, buffer_size, "SALIDA %d: %s",
-                 output_num, cmd_info->state ? "ON" : "OFF");
+        if (outputs[i].state)
+        {
+            bitmap |= (uint8_t)(1u << i);
+        }
     }
+    return bitmap;
 }
 
 // Función para inicializar GPIO de manera optimizada
@@ -134,7 +78,7 @@ static cy_rslt_t initialize_gpio_outputs(void)
 
         if (gpio_result != CY_RSLT_SUCCESS)
         {
-            printf("ERROR: GPIO %d init failed: 0x%lX\n", i + 1, gpio_result);
+            printf("ERROR: GPIO %d init failed: 0x%lX\n", i + 1, (unsigned long)gpio_result);
             result = gpio_result; // Guardar el primer error pero continuar
         }
     }
@@ -165,7 +109,6 @@ void control(void *arg)
 
     message_t received_msg;
     message_t response_msg;
-    char response_buffer[64];
 
     // Variables de optimización
     TickType_t queue_timeout = pdMS_TO_TICKS(50); // Timeout más corto
@@ -174,8 +117,9 @@ void control(void *arg)
     for (;;)
     {
         // Recepción optimizada con timeout más corto
-        if (xQueueReceive(control_params->queue_tcp_to_control, &received_msg, queue_timeout) == pdTRUE)
+        if (queue_monitor_receive(control_params->queue_tcp_to_control, &received_msg, queue_timeout) == pdTRUE)
         {
+            latency_monitor_stamp(&received_msg, LATENCY_DEQUEUE);
 
             processed_commands++;
 
@@ -183,44 +127,36 @@ void control(void *arg)
             response_msg.command = CMD_CONTROL_TO_TCP;
             response_msg.value = received_msg.value; // Mantener client ID
 
-            // Limpiar caracteres de control (optimizado)
-            char *cmd_start = received_msg.data;
-            while (*cmd_start == ' ' || *cmd_start == '\t')
-                cmd_start++; // Skip whitespace
+            // El servidor ya parseó el comando: solo queda ejecutarlo
+            const command_desc_t *cmd = &received_msg.cmd;
+            int cmd_index = command_index(cmd);
+            latency_monitor_stamp(&received_msg, LATENCY_LOOKUP);
 
-            size_t cmd_len = strlen(cmd_start);
-            if (cmd_len > 0 && (cmd_start[cmd_len - 1] == '\n' || cmd_start[cmd_len - 1] == '\r'))
+            if (cmd->opcode == COMMAND_OP_SET)
             {
-                cmd_len--; // Remove trailing newline
-                cmd_start[cmd_len] = '\0';
+                // Comando de control
+                apply_command_bitmask(cmd->mask, cmd->value != 0);
+                latency_monitor_stamp(&received_msg, LATENCY_GPIO);
             }
 
-            // Búsqueda optimizada del comando
-            const command_lookup_t *cmd_info = find_command_fast(cmd_start, cmd_len);
+            response_msg.cmd = *cmd;
+            response_msg.outputs = outputs_bitmap();
 
-            if (cmd_info)
+            // El log muestra el descriptor; el texto de la respuesta lo arma
+            // solo el servidor al enviarla
+            if (cmd_index >= 0)
             {
-                if (cmd_info->is_status)
-                {
-                    // Comando de estado
-                    generate_status_response(response_buffer, sizeof(response_buffer));
-                }
-                else
-                {
-                    // Comando de control
-                    apply_command_bitmask(cmd_info->output_mask, cmd_info->state);
-                    generate_command_response(cmd_info, response_buffer, sizeof(response_buffer));
-                }
-
-                strcpy(response_msg.data, response_buffer);
-                printf("Control[%lu]: %s -> %s\n", processed_commands, cmd_start, response_buffer);
-                printf("Comandos procesados: %lu\n", processed_commands);
+                command_stats[cmd_index]++; // Actualizar estadísticas
+                printf("Control[%lu]: cliente %lu %s (op=%u mask=0x%02X value=%u) -> salidas=0x%02X\n",
+                       (unsigned long)processed_commands, (unsigned long)received_msg.value,
+                       command_name(cmd_index), cmd->opcode, cmd->mask, cmd->value, response_msg.outputs);
+                printf("Comandos procesados: %lu\n", (unsigned long)processed_commands);
                 printf("Comandos mas usados:\n");
-                for (int i = 0; i < 5 && i < COMMAND_TABLE_SIZE; i++)
+                for (int i = 0; i < 5 && i < COMMAND_COUNT; i++)
                 {
                     if (command_stats[i] > 0)
                     {
-                        printf("  %s: %lu veces\n\n", command_table[i].cmd, command_stats[i]);
+                        printf("  %s: %lu veces\n\n", command_name(i), (unsigned long)command_stats[i]);
                     }
                 }
                 printf("Estado actual: S1=%s S2=%s S3=%s S4=%s\n",
@@ -235,23 +171,31 @@ void control(void *arg)
                 // Comando no reconocido
                 printf("\x1b[0m"); 
                 printf("\x1b[30m");  
-                strcpy(response_msg.data, "COMANDO NO RECONOCIDO");
-                printf("Control: Comando invalido: '%s'\n", cmd_start);
+                printf("Control: Comando invalido de cliente %lu (op=%u mask=0x%02X value=%u)\n",
+                       (unsigned long)received_msg.value, cmd->opcode, cmd->mask, cmd->value);
             }
 
+            // La respuesta hereda las marcas de latencia del comando
+            memcpy(response_msg.stamps, received_msg.stamps, sizeof(response_msg.stamps));
+            latency_monitor_stamp(&response_msg, LATENCY_REPLY_ENQUEUE);
+
             // Envío optimizado de respuesta
-            BaseType_t send_result = xQueueSend(control_params->queue_control_to_tcp,
-                                                &response_msg, pdMS_TO_TICKS(100));
+            BaseType_t send_result = queue_monitor_send(control_params->queue_control_to_tcp,
+                                                        &response_msg, pdMS_TO_TICKS(100));
 
             if (send_result != pdTRUE)
             {
                 printf("Control: ERROR - Cola TCP llena\n");
             }
+            else
+            {
+                tcp_server_notify_reply(response_msg.value);
+            }
         }
 
 
         // Yield más inteligente - solo si no hay mensajes pendientes
-        if (uxQueueMessagesWaiting(control_params->queue_tcp_to_control) == 0)
+        if (queue_monitor_waiting(control_params->queue_tcp_to_control) == 0)
         {
             vTaskDelay(pdMS_TO_TICKS(5)); // Delay más corto cuando no hay trabajo
         }
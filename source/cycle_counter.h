@@ -0,0 +1,28 @@
+#ifndef CYCLE_COUNTER_H_
+#define CYCLE_COUNTER_H_
+
+#include "cyhal.h"
+#include <stdint.h>
+
+// Contador de ciclos del DWT (Cortex-M4). Da la vuelta cada 2^32 ciclos
+// (~28 s a 150 MHz): las diferencias con aritmética sin signo son válidas
+// mientras el intervalo medido sea menor.
+
+static inline void cycle_counter_init(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+static inline uint32_t cycle_counter_now(void)
+{
+    return DWT->CYCCNT;
+}
+
+static inline uint32_t cycles_to_us(uint32_t cycles)
+{
+    return cycles / (SystemCoreClock / 1000000u);
+}
+
+#endif /* CYCLE_COUNTER_H_ */
@@ -0,0 +1,182 @@
+#include "cyhal.h"
+#include "cyabs_rtos.h"
+#include <FreeRTOS.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <unistd.h>
+#include "heap_monitor.h"
+#include "report.h"
+#include "config.h"
+
+// SRAM libre según el linker script: del final de .bss (__HeapBase) al tope
+// de la SRAM menos la pila de arranque (__HeapLimit). newlib la reparte con
+// sbrk() a partir del break actual.
+extern uint8_t __HeapBase[];
+extern uint8_t __HeapLimit[];
+
+// Una sola región: heap_5 toma con sbrk() todo lo que newlib no usó al
+// arrancar, salvo HEAP_NEWLIB_RESERVE, que queda sobre el break para malloc()
+static HeapRegion_t heap_regions[2];
+static size_t heap_total_bytes = 0;
+static size_t heap_spare_bytes = 0; // Del break a __HeapLimit, antes de tomar la región
+
+// Contador de asignaciones en régimen permanente
+#define HEAP_MAX_WATCHED_TASKS (MAX_CLIENTS + 4)
+
+static TaskHandle_t watched_tasks[HEAP_MAX_WATCHED_TASKS];
+static int watched_count = 0;
+static volatile bool steady_state = false;
+static volatile TaskHandle_t allowed_task = NULL;
+static volatile uint32_t steady_allocs_watched = 0;
+static volatile uint32_t steady_allocs_other = 0;
+static volatile uint32_t last_violation_size = 0;
+
+void heap_monitor_init(void)
+{
+    uint8_t *current_break = sbrk(0);
+    void *region = (void *)-1;
+
+    if (current_break >= __HeapBase && current_break <= __HeapLimit)
+    {
+        heap_spare_bytes = (size_t)(__HeapLimit - current_break);
+    }
+    if (heap_spare_bytes > HEAP_NEWLIB_RESERVE)
+    {
+        region = sbrk((intptr_t)(heap_spare_bytes - HEAP_NEWLIB_RESERVE));
+    }
+    if (region != (void *)-1)
+    {
+        heap_regions[0].pucStartAddress = region;
+        heap_regions[0].xSizeInBytes = heap_spare_bytes - HEAP_NEWLIB_RESERVE;
+        heap_total_bytes = heap_regions[0].xSizeInBytes;
+    }
+    heap_regions[1].pucStartAddress = NULL;
+    heap_regions[1].xSizeInBytes = 0;
+
+    // La UART aún no existe: heap_monitor_log_regions lo informa después
+    configASSERT(heap_total_bytes >= HEAP_REGION_MIN_SIZE);
+
+    vPortDefineHeapRegions(heap_regions);
+}
+
+void heap_monitor_log_regions(void)
+{
+    uint8_t *region = heap_regions[0].pucStartAddress;
+
+    printf("heap_5: %u bytes en 0x%08lx-0x%08lx (minimo %u), reserva de newlib %u de %u libres\n",
+           (unsigned)heap_total_bytes, (unsigned long)(uintptr_t)region,
+           (unsigned long)(uintptr_t)(region + heap_total_bytes), (unsigned)HEAP_REGION_MIN_SIZE,
+           (unsigned)HEAP_NEWLIB_RESERVE, (unsigned)heap_spare_bytes);
+    if (heap_total_bytes < HEAP_REGION_MIN_SIZE)
+    {
+        printf("ERROR: heap_5 sin la SRAM configurada (ajustar HEAP_NEWLIB_RESERVE o el linker script)\n");
+    }
+}
+
+void heap_monitor_get_stats(HeapStats_t *stats)
+{
+    vPortGetHeapStats(stats);
+}
+
+bool heap_monitor_can_admit(size_t bytes)
+{
+    HeapStats_t stats;
+    vPortGetHeapStats(&stats);
+
+    return stats.xSizeOfLargestFreeBlockInBytes >= bytes &&
+           stats.xAvailableHeapSpaceInBytes >= bytes + HEAP_RESERVE_BYTES;
+}
+
+void heap_monitor_watch_task(TaskHandle_t task)
+{
+    if (task != NULL && watched_count < HEAP_MAX_WATCHED_TASKS)
+    {
+        watched_tasks[watched_count++] = task;
+    }
+}
+
+void heap_monitor_steady_state_begin(void)
+{
+    steady_allocs_watched = 0;
+    steady_allocs_other = 0;
+    steady_state = true;
+}
+
+void heap_monitor_allow_begin(void)
+{
+    allowed_task = xTaskGetCurrentTaskHandle();
+}
+
+void heap_monitor_allow_end(void)
+{
+    allowed_task = NULL;
+}
+
+void heap_monitor_on_malloc(void *ptr, size_t size)
+{
+    if (!steady_state || ptr == NULL)
+    {
+        return;
+    }
+
+    TaskHandle_t current = xTaskGetCurrentTaskHandle();
+    if (current == allowed_task)
+    {
+        return;
+    }
+
+    for (int i = 0; i < watched_count; i++)
+    {
+        if (watched_tasks[i] == current)
+        {
+            steady_allocs_watched++;
+            last_violation_size = size;
+#if defined(APP_ZERO_HEAP)
+            configASSERT(0); // Asignación en el camino de comandos: ver la pila de llamadas
+#endif
+            return;
+        }
+    }
+
+    steady_allocs_other++;
+}
+
+int heap_monitor_report(char *buffer, size_t buffer_size)
+{
+    HeapStats_t stats;
+    vPortGetHeapStats(&stats);
+
+    // Fragmentación: fracción de la memoria libre que no está en el bloque mayor
+    uint32_t fragmentation = 0;
+    if (stats.xAvailableHeapSpaceInBytes > 0)
+    {
+        fragmentation = 100 - (stats.xSizeOfLargestFreeBlockInBytes * 100) / stats.xAvailableHeapSpaceInBytes;
+    }
+
+    int len = report_append(buffer, buffer_size, 0,
+                            "=== HEAP (heap_5, %u bytes) ===\n"
+                            "Libre: %u  Minimo historico: %u\n"
+                            "Bloque mayor: %u  Bloque menor: %u  Bloques libres: %u\n"
+                            "Fragmentacion: %lu%%\n"
+                            "Asignaciones: %u  Liberaciones: %u  Vivas: %u\n",
+                            (unsigned)heap_total_bytes,
+                            (unsigned)stats.xAvailableHeapSpaceInBytes,
+                            (unsigned)stats.xMinimumEverFreeBytesRemaining,
+                            (unsigned)stats.xSizeOfLargestFreeBlockInBytes,
+                            (unsigned)stats.xSizeOfSmallestFreeBlockInBytes,
+                            (unsigned)stats.xNumberOfFreeBlocks,
+                            (unsigned long)fragmentation,
+                            (unsigned)stats.xNumberOfSuccessfulAllocations,
+                            (unsigned)stats.xNumberOfSuccessfulFrees,
+                            (unsigned)(stats.xNumberOfSuccessfulAllocations - stats.xNumberOfSuccessfulFrees));
+
+    if (steady_state)
+    {
+        len = report_append(buffer, buffer_size, len,
+                            "Regimen permanente (pvPortMalloc): %lu asignaciones en tareas vigiladas (ultima %lu B), %lu en otras\n",
+                            (unsigned long)steady_allocs_watched, (unsigned long)last_violation_size,
+                            (unsigned long)steady_allocs_other);
+    }
+    return len;
+}
@@ -0,0 +1,42 @@
+#ifndef HEAP_MONITOR_H_
+#define HEAP_MONITOR_H_
+
+#include <FreeRTOS.h>
+#include <task.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// Define las regiones de heap_5 con la SRAM libre del linker. Debe llamarse
+// antes de crear cualquier objeto del kernel (incluido cy_retarget_io_init,
+// que crea un mutex).
+void heap_monitor_init(void);
+
+// Imprime la región obtenida y la reserva de newlib (una vez lista la UART)
+void heap_monitor_log_regions(void);
+
+// Estadísticas actuales de heap_5
+void heap_monitor_get_stats(HeapStats_t *stats);
+
+// true si un bloque de 'bytes' cabe y aún quedan HEAP_RESERVE_BYTES libres
+bool heap_monitor_can_admit(size_t bytes);
+
+// Modo APP_ZERO_HEAP: las tareas vigiladas no deben asignar memoria una vez
+// iniciado el régimen permanente (configASSERT en el hook traceMALLOC).
+// Las asignaciones de otras tareas (lwIP, WHD) solo se cuentan.
+// Solo se vigila el heap del kernel (pvPortMalloc). El malloc de newlib
+// (printf, WHD, lwIP y mbedTLS, dentro de HEAP_NEWLIB_RESERVE) no pasa por el hook
+// y no se cuenta.
+void heap_monitor_watch_task(TaskHandle_t task);
+void heap_monitor_steady_state_begin(void);
+
+// Ventana en la que la tarea actual puede asignar (p. ej. accept del transporte)
+void heap_monitor_allow_begin(void);
+void heap_monitor_allow_end(void);
+
+// Hook de traceMALLOC (llamado con el scheduler suspendido)
+void heap_monitor_on_malloc(void *ptr, size_t size);
+
+// Reporte de memoria libre, mínimo histórico, fragmentación y asignaciones
+int heap_monitor_report(char *buffer, size_t buffer_size);
+
+#endif /* HEAP_MONITOR_H_ */
@@ -0,0 +1,100 @@
+#include <string.h>
+#include "histogram.h"
+#include "report.h"
+
+#define SUB_BUCKETS (1u << HISTOGRAM_SUB_BITS)
+
+static uint32_t bucket_index(uint32_t value)
+{
+    if (value < SUB_BUCKETS)
+    {
+        return value;
+    }
+    if (value >= (1u << HISTOGRAM_MAX_BITS))
+    {
+        return HISTOGRAM_BUCKETS - 1;
+    }
+
+    uint32_t shift = (31 - __builtin_clz(value)) - HISTOGRAM_SUB_BITS;
+    return ((shift + 1) << HISTOGRAM_SUB_BITS) + ((value >> shift) - SUB_BUCKETS);
+}
+
+// Mayor valor que cae en la cubeta
+static uint32_t bucket_upper(uint32_t index)
+{
+    if (index < SUB_BUCKETS)
+    {
+        return index;
+    }
+
+    uint32_t shift = (index >> HISTOGRAM_SUB_BITS) - 1;
+    uint32_t base = (index & (SUB_BUCKETS - 1)) + SUB_BUCKETS;
+    return ((base + 1) << shift) - 1;
+}
+
+void histogram_reset(histogram_t *hist)
+{
+    memset(hist, 0, sizeof(*hist));
+    hist->min = UINT32_MAX;
+}
+
+void histogram_record(histogram_t *hist, uint32_t value)
+{
+    hist->buckets[bucket_index(value)]++;
+    hist->count++;
+    hist->sum += value;
+    if (value < hist->min)
+    {
+        hist->min = value;
+    }
+    if (value > hist->max)
+    {
+        hist->max = value;
+    }
+}
+
+uint32_t histogram_percentile(const histogram_t *hist, uint32_t per_mille)
+{
+    if (hist->count == 0)
+    {
+        return 0;
+    }
+
+    // Rango de la muestra buscada (redondeo hacia arriba, mínimo 1)
+    uint64_t target = ((uint64_t)hist->count * per_mille + 999) / 1000;
+    uint64_t seen = 0;
+
+    if (target == 0)
+    {
+        target = 1;
+    }
+
+    for (uint32_t i = 0; i < HISTOGRAM_BUCKETS; i++)
+    {
+        seen += hist->buckets[i];
+        if (seen >= target && i < HISTOGRAM_BUCKETS - 1)
+        {
+            uint32_t upper = bucket_upper(i);
+            return (upper < hist->max) ? upper : hist->max;
+        }
+    }
+    return hist->max;
+}
+
+int histogram_report(const histogram_t *hist, const char *name, const char *unit,
+                     char *buffer, size_t buffer_size, int len)
+{
+    if (hist->count == 0)
+    {
+        return report_append(buffer, buffer_size, len, "%s: sin muestras\n", name);
+    }
+
+    return report_append(buffer, buffer_size, len,
+                         "%s (%s): n=%lu min=%lu p50=%lu p90=%lu p99=%lu p999=%lu max=%lu\n",
+                         name, unit, (unsigned long)hist->count, (unsigned long)hist->min,
+                         (unsigned long)histogram_percentile(hist, 500),
+                         (unsigned long)histogram_percentile(hist, 900),
+                         (unsigned long)histogram_percentile(hist, 990),
+                         (unsigned long)histogram_percentile(hist, 999),
+                         (unsigned long)hist->max);
+}
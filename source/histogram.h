@@ -0,0 +1,37 @@
+#ifndef HISTOGRAM_H_
+#define HISTOGRAM_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Histograma log-lineal de memoria fija: valores menores que
+// 2^HISTOGRAM_SUB_BITS van en cubetas exactas y cada potencia de 2 superior se
+// divide en 2^HISTOGRAM_SUB_BITS cubetas (error relativo < 12.5%). Los valores
+// desde 2^HISTOGRAM_MAX_BITS caen en la última cubeta; max guarda el exacto.
+// No es reentrante: quien lo comparte entre tareas debe protegerlo.
+
+#define HISTOGRAM_SUB_BITS 3
+#define HISTOGRAM_MAX_BITS 24 // 16.7 s en microsegundos
+#define HISTOGRAM_BUCKETS ((HISTOGRAM_MAX_BITS - HISTOGRAM_SUB_BITS + 1) << HISTOGRAM_SUB_BITS)
+
+typedef struct
+{
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t sum;
+    uint32_t buckets[HISTOGRAM_BUCKETS];
+} histogram_t;
+
+void histogram_reset(histogram_t *hist);
+
+void histogram_record(histogram_t *hist, uint32_t value);
+
+// Cota superior del valor bajo el que cae per_mille/1000 de las muestras
+uint32_t histogram_percentile(const histogram_t *hist, uint32_t per_mille);
+
+// Una línea "nombre: n= min= p50= p90= p99= p999= max=" con la unidad dada
+int histogram_report(const histogram_t *hist, const char *name, const char *unit,
+                     char *buffer, size_t buffer_size, int len);
+
+#endif /* HISTOGRAM_H_ */
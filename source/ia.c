@@ -7,11 +7,19 @@
 #include <string.h>
 #include <float.h>
 #include <math.h>
+#include "arm_math.h"
 
 #include <models/model1audio.h>
+#include <models/model1audio_frontend.h>
 #include "config.h"
 #include "ia.h"
 #include "types.h"
+#include "queue_monitor.h"
+#include "histogram.h"
+#include "report.h"
+#include "cycle_counter.h"
+#include "trace_recorder.h"
+#include "arena.h"
 
 /*******************************************************************************
  * DEEPCRAFT compatibility defines
@@ -35,12 +43,84 @@
 static bool ml_initialized = false;
 static float sample_max_slow = 0;
 
+// Captura por DMA en dos buffers: mientras la tarea procesa uno, el DMA llena
+// el otro. El callback de fin de transferencia relanza el DMA y pasa el
+// buffer lleno a la tarea con una notificación (valor = índice del buffer).
+static int16_t (*audio_buffers)[AUDIO_BUFFER_SIZE]; // Región de captura de la arena
+static volatile uint8_t dma_buffer = 0;   // Buffer que está llenando el DMA
+static volatile int8_t task_buffer = -1;  // Buffer en manos de la tarea, -1 si ninguno
+static TaskHandle_t ia_task_handle = NULL;
+static audio_capture_stats_t capture_stats;
+static histogram_t process_us; // Procesamiento por bloque; presupuesto = AUDIO_BLOCK_US
+#if defined(IMAI_FRONTEND_CHECK)
+static IMAI_frontend_check_t frontend_check; // Resultado de la comprobación al iniciar
+#endif
+
+// Arena de la tarea: la arena de TFLM, el scratch del front-end y los buffers
+// de captura salen de un solo pool, planificado al iniciar según las fases en
+// que vive cada región. Sin APP_SHARED_ARENA ninguna convive con otra y el
+// pico es la suma; con él, el scratch (comprobación y front-end) va dentro de
+// la cabeza no persistente de TFLM (carga e inferencia).
+enum
+{
+    IA_PHASE_LOAD,     // mtb_ml_model_init: TFLM usa la cabeza como temporal
+    IA_PHASE_CHECK,    // Comprobaciones de arranque
+    IA_PHASE_FRONTEND, // Un salto de 320 muestras
+    IA_PHASE_INFERENCE,
+    IA_PHASE_COUNT
+};
+#define IA_PHASES_ALL (ARENA_PHASE(IA_PHASE_COUNT) - 1)
+#define IA_PHASES_STREAM (ARENA_PHASE(IA_PHASE_FRONTEND) | ARENA_PHASE(IA_PHASE_INFERENCE))
+
+enum
+{
+    IA_REGION_TFLM, // Arena entera, o solo su cabeza con APP_SHARED_ARENA
+#if defined(APP_SHARED_ARENA)
+    IA_REGION_TFLM_PERSISTENT,
+#endif
+    IA_REGION_SCRATCH,
+    IA_REGION_CAPTURE,
+    IA_REGION_COUNT
+};
+
+#define IA_CAPTURE_BYTES (2 * AUDIO_BUFFER_SIZE * sizeof(int16_t))
+#if defined(APP_SHARED_ARENA)
+#define IA_ARENA_SIZE (IMAI_TFLM_ARENA_SIZE + IA_CAPTURE_BYTES)
+#else
+#define IA_ARENA_SIZE (IMAI_TFLM_ARENA_SIZE + IMAI_SCRATCH_SIZE + IA_CAPTURE_BYTES)
+#endif
+
+static const char *const ia_phase_names[IA_PHASE_COUNT] = {"carga", "comprobacion", "front-end", "inferencia"};
+static arena_region_t ia_regions[IA_REGION_COUNT] = {
+#if defined(APP_SHARED_ARENA)
+    [IA_REGION_TFLM] = {"tflm cabeza", TFLM_ARENA_HEAD_BYTES,
+                        ARENA_PHASE(IA_PHASE_LOAD) | ARENA_PHASE(IA_PHASE_INFERENCE), 0},
+    [IA_REGION_TFLM_PERSISTENT] = {"tflm persistente", IMAI_TFLM_ARENA_SIZE - TFLM_ARENA_HEAD_BYTES,
+                                   IA_PHASES_ALL, TFLM_ARENA_HEAD_BYTES},
+#else
+    [IA_REGION_TFLM] = {"tflm", IMAI_TFLM_ARENA_SIZE, IA_PHASES_ALL, 0},
+#endif
+    [IA_REGION_SCRATCH] = {"front-end", IMAI_SCRATCH_SIZE,
+                           ARENA_PHASE(IA_PHASE_CHECK) | ARENA_PHASE(IA_PHASE_FRONTEND), ARENA_UNPLACED},
+    [IA_REGION_CAPTURE] = {"captura", IA_CAPTURE_BYTES, IA_PHASES_STREAM, ARENA_UNPLACED},
+};
+static uint8_t ia_pool[IA_ARENA_SIZE] __attribute__((aligned(ARENA_ALIGN)));
+static arena_t ia_arena = {
+    .pool = ia_pool,
+    .pool_size = IA_ARENA_SIZE,
+    .regions = ia_regions,
+    .count = IA_REGION_COUNT,
+    .phase_names = ia_phase_names,
+    .phase_count = IA_PHASE_COUNT,
+};
+
 /*******************************************************************************
  * Static Function Prototypes
  *******************************************************************************/
 static cy_rslt_t configure_audio_clocks(cyhal_clock_t *audio_clock, cyhal_clock_t *pll_clock);
 static void pdm_frequency_fix(void);
-static float normalize_and_boost_sample(int16_t sample);
+static void pdm_event_callback(void *arg, cyhal_pdm_pcm_event_t event);
+static cy_rslt_t start_audio_capture(cyhal_pdm_pcm_t *pdm_pcm);
 
 /*******************************************************************************
  * Function Name: tarea_ia
@@ -73,7 +153,7 @@ void tarea_ia(void *arg)
     result = init_ml_model();
     if (result != CY_RSLT_SUCCESS)
     {
-        printf("ERROR: No se pudo inicializar el modelo ML (0x%08lX)\n", result);
+        printf("ERROR: No se pudo inicializar el modelo ML (0x%08lX)\n", (unsigned long)result);
         vTaskDelete(NULL);
         return;
     }
@@ -82,18 +162,39 @@ void tarea_ia(void *arg)
     result = init_audio_system(&pdm_pcm);
     if (result != CY_RSLT_SUCCESS)
     {
-        printf("ERROR: No se pudo inicializar el sistema de audio (0x%08lX)\n", result);
+        printf("ERROR: No se pudo inicializar el sistema de audio (0x%08lX)\n", (unsigned long)result);
         vTaskDelete(NULL);
         return;
     }
 
     printf("Sistema IA inicializado correctamente\n");
 
-    /* Main processing loop */
+    /* Main processing loop: sin retardo fijo, el ritmo lo marca el DMA */
     while (true)
     {
+        uint32_t buffer_index;
+
+        if (xTaskNotifyWait(0, 0, &buffer_index, pdMS_TO_TICKS(AUDIO_CAPTURE_TIMEOUT_MS)) != pdTRUE)
+        {
+            // Sin bloques del DMA: se relanza la captura
+            printf("IA: sin audio en %d ms, relanzando captura\n", AUDIO_CAPTURE_TIMEOUT_MS);
+            capture_stats.restarts++;
+            cyhal_pdm_pcm_abort_async(&pdm_pcm);
+            xTaskNotifyStateClear(NULL); // Descarta un aviso que llegara antes del abort
+            start_audio_capture(&pdm_pcm);
+            continue;
+        }
+
         /* Process audio and get ML results */
-        result = process_audio_buffer(&pdm_pcm, &ml_result);
+        uint32_t start = cycle_counter_now();
+        result = process_audio_buffer(audio_buffers[buffer_index], AUDIO_BUFFER_SIZE, &ml_result);
+        uint32_t elapsed_us = cycles_to_us(cycle_counter_now() - start);
+
+        task_buffer = -1; // El DMA ya puede volver a llenarlo
+        taskENTER_CRITICAL();
+        capture_stats.processed++;
+        histogram_record(&process_us, elapsed_us);
+        taskEXIT_CRITICAL();
 
         if (result == CY_RSLT_SUCCESS && ml_result.detection_active)
         {
@@ -110,12 +211,12 @@ void tarea_ia(void *arg)
                 message_t voice_command = {
                     .command = CMD_TCP_TO_CONTROL,
                     .value = 0,  // Broadcast a todos los clientes
-                    .data = "ALL_OFF"
+                    .cmd = {COMMAND_OP_SET, COMMAND_ALL_OUTPUTS, 0} // ALL_OFF
                 };
                 
                 // Enviar comando a la cola de control
-                BaseType_t send_result = xQueueSend(ia_params->queue_tcp_to_control, 
-                                                   &voice_command, pdMS_TO_TICKS(100));
+                BaseType_t send_result = queue_monitor_send(ia_params->queue_tcp_to_control,
+                                                            &voice_command, pdMS_TO_TICKS(100));
                 
                 if (send_result == pdTRUE) {
                     printf("Comando ALL_OFF enviado por detección de voz\n");
@@ -124,9 +225,6 @@ void tarea_ia(void *arg)
                 }
             }
         }
-
-        /* Small delay to prevent CPU saturation */
-        vTaskDelay(pdMS_TO_TICKS(35));
     }
 }
 
@@ -141,11 +239,44 @@ void tarea_ia(void *arg)
  *******************************************************************************/
 cy_rslt_t init_ml_model(void)
 {
-    cy_rslt_t result = IMAI_init();
+    cy_rslt_t result;
+
+    if (!arena_plan(&ia_arena))
+    {
+        printf("ERROR: Arena IA: pico de %lu bytes en un pool de %lu\n",
+               (unsigned long)ia_arena.peak, (unsigned long)ia_arena.pool_size);
+        return CY_RSLT_TYPE_ERROR;
+    }
+    printf("Arena IA: pico %lu bytes (sin solapar %lu)\n",
+           (unsigned long)ia_arena.peak, (unsigned long)ia_arena.total);
+    audio_buffers = arena_ptr(&ia_arena, IA_REGION_CAPTURE);
+    IMAI_set_arena(arena_ptr(&ia_arena, IA_REGION_SCRATCH), arena_ptr(&ia_arena, IA_REGION_TFLM));
+
+    result = IMAI_init();
+#if defined(APP_SHARED_ARENA)
+    if (result == CY_RSLT_SUCCESS && IMAI_arena_check() != IMAI_RET_SUCCESS)
+    {
+        printf("ERROR: TFLM guarda datos persistentes en los primeros %d bytes de su arena\n",
+               TFLM_ARENA_HEAD_BYTES);
+        result = CY_RSLT_TYPE_ERROR;
+    }
+#endif
 
     if (result == CY_RSLT_SUCCESS)
     {
         ml_initialized = true;
+#if defined(IMAI_FRONTEND_CHECK)
+        /* Variante del front-end contra el generado, antes de empezar a capturar */
+        if (IMAI_frontend_check(cycle_counter_now, &frontend_check) != IMAI_RET_SUCCESS)
+        {
+            printf("ADVERTENCIA: front-end %s fuera de tolerancia en %d bandas\n",
+                   frontend_check.variant, frontend_check.failed_features);
+        }
+        printf("Front-end %s: error max %.2e (ln %.2e, log-mel %.2e), ciclos por trama ref=%lu %s=%lu\n",
+               frontend_check.variant, frontend_check.max_rel_error, frontend_check.max_log_error,
+               frontend_check.max_abs_error, (unsigned long)frontend_check.ref_cycles,
+               frontend_check.variant, (unsigned long)frontend_check.fast_cycles);
+#endif
     }
     else
     {
@@ -206,6 +337,19 @@ cy_rslt_t init_audio_system(cyhal_pdm_pcm_t *pdm_pcm)
     /* Apply frequency fix workaround */
     pdm_frequency_fix();
 
+    /* Lecturas asíncronas por DMA con aviso al completar cada bloque */
+    result = cyhal_pdm_pcm_set_async_mode(pdm_pcm, CYHAL_ASYNC_DMA, CYHAL_DMA_PRIORITY_DEFAULT);
+    if (result != CY_RSLT_SUCCESS)
+    {
+        return result;
+    }
+
+    ia_task_handle = xTaskGetCurrentTaskHandle();
+    histogram_reset(&process_us);
+    cyhal_pdm_pcm_register_callback(pdm_pcm, pdm_event_callback, pdm_pcm);
+    cyhal_pdm_pcm_enable_event(pdm_pcm, CYHAL_PDM_PCM_ASYNC_COMPLETE | CYHAL_PDM_PCM_RX_OVERFLOW,
+                               PDM_ISR_PRIORITY, true);
+
     /* Start PDM/PCM */
     result = cyhal_pdm_pcm_start(pdm_pcm);
     if (result != CY_RSLT_SUCCESS)
@@ -213,31 +357,29 @@ cy_rslt_t init_audio_system(cyhal_pdm_pcm_t *pdm_pcm)
         return result;
     }
 
-    return CY_RSLT_SUCCESS;
+    return start_audio_capture(pdm_pcm);
 }
 
 /*******************************************************************************
  * Function Name: process_audio_buffer
  ********************************************************************************
  * Summary:
- * Processes audio buffer through ML model and returns results.
+ * Processes a captured audio block through ML model and returns results.
  *
  * Parameters:
- *  pdm_pcm - Pointer to PDM/PCM structure
- *  result  - Pointer to ML result structure
+ *  audio_buffer - Block filled by the DMA
+ *  audio_count  - Samples in the block
+ *  result       - Pointer to ML result structure
  *
  * Return:
  *  cy_rslt_t - Result of processing
  *******************************************************************************/
-cy_rslt_t process_audio_buffer(cyhal_pdm_pcm_t *pdm_pcm, ml_result_t *result)
+cy_rslt_t process_audio_buffer(const int16_t *audio_buffer, size_t audio_count, ml_result_t *result)
 {
-    static int16_t audio_buffer[AUDIO_BUFFER_SIZE] = {0};
     static float label_scores[IMAI_DATA_OUT_COUNT];
     static char *label_text[] = IMAI_DATA_OUT_SYMBOLS;
 
-    size_t audio_count;
-    cy_rslt_t cy_result;
-    float sample, sample_abs, sample_max = 0;
+    float sample_max;
     int ml_status;
 
     /* Initialize result structure */
@@ -248,72 +390,45 @@ cy_rslt_t process_audio_buffer(cyhal_pdm_pcm_t *pdm_pcm, ml_result_t *result)
     result->best_label = 0;
     result->max_score = -1000.0f;
 
-    /* Read audio data */
-    audio_count = AUDIO_BUFFER_SIZE;
-    memset(audio_buffer, 0, AUDIO_BUFFER_SIZE * sizeof(int16_t));
-    cy_result = cyhal_pdm_pcm_read(pdm_pcm, (void *)audio_buffer, &audio_count);
-
-    if (cy_result != CY_RSLT_SUCCESS)
-    {
-        return cy_result;
-    }
-
     /* Update volume tracking */
     sample_max_slow -= 0.0005f;
 
-    /* Process each sample */
-    for (int i = 0; i < audio_count; i++)
+    /* Pico del bloque sobre las muestras crudas (SIMD): normalizar y recortar no cambian el orden */
+    q15_t peak;
+    uint32_t peak_index;
+    arm_absmax_q15(audio_buffer, (uint32_t)audio_count, &peak, &peak_index);
+    sample_max = fminf(peak * AUDIO_SAMPLE_GAIN, 1.0f);
+    if (sample_max > sample_max_slow)
     {
-        /* Normalize and boost sample */
-        sample = normalize_and_boost_sample(audio_buffer[i]);
-
-        /* Enqueue sample to ML model */
-        cy_result = IMAI_enqueue(&sample);
-        if (cy_result != CY_RSLT_SUCCESS)
-        {
-            return cy_result;
-        }
-
-        /* Track maximum sample for volume monitoring */
-        sample_abs = fabs(sample);
-        if (sample_abs > sample_max)
-        {
-            sample_max = sample_abs;
-        }
-
-        if (sample_max > sample_max_slow)
-        {
-            sample_max_slow = sample_max;
-        }
+        sample_max_slow = sample_max;
+    }
 
-        /* Check for ML model output */
-        ml_status = IMAI_dequeue(label_scores);
+    /* Bloque completo al modelo: conversión con CMSIS-DSP directo a su ventana y
+       front-end por salto de 320 muestras. Con bloques de 512 y una salida cada
+       1920 muestras hay como mucho una salida por bloque. */
+    ml_status = IMAI_enqueue_block(audio_buffer, (int)audio_count, DIGITAL_BOOST_FACTOR, label_scores);
 
-        switch (ml_status)
+    switch (ml_status)
+    {
+    case IMAI_RET_SUCCESS:
+        /* Find best label */
+        for (int j = 0; j < IMAI_DATA_OUT_COUNT; j++)
         {
-        case IMAI_RET_SUCCESS:
-            /* Find best label */
-            for (int j = 0; j < IMAI_DATA_OUT_COUNT; j++)
+            if (label_scores[j] > result->max_score)
             {
-                if (label_scores[j] > result->max_score)
-                {
-                    result->max_score = label_scores[j];
-                    result->best_label = j;
-                }
+                result->max_score = label_scores[j];
+                result->best_label = j;
             }
-            result->detection_active = true;
-            break;
-
-        case IMAI_RET_NODATA:
-            /* No new output, continue processing */
-            break;
+        }
+        result->detection_active = true;
+        break;
 
-        case IMAI_RET_ERROR:
-            return CY_RSLT_TYPE_ERROR;
+    case IMAI_RET_NODATA:
+        /* No new output */
+        break;
 
-        default:
-            break;
-        }
+    default:
+        return CY_RSLT_TYPE_ERROR;
     }
 
     return CY_RSLT_SUCCESS;
@@ -383,15 +498,137 @@ void print_ml_results(ml_result_t *result)
  *******************************************************************************/
 void cleanup_audio_system(cyhal_pdm_pcm_t *pdm_pcm)
 {
+    cyhal_pdm_pcm_abort_async(pdm_pcm);
+    cyhal_pdm_pcm_enable_event(pdm_pcm, CYHAL_PDM_PCM_ASYNC_COMPLETE | CYHAL_PDM_PCM_RX_OVERFLOW,
+                               PDM_ISR_PRIORITY, false);
     cyhal_pdm_pcm_stop(pdm_pcm);
     cyhal_pdm_pcm_free(pdm_pcm);
     printf("Sistema de audio liberado\n");
 }
 
+/*******************************************************************************
+ * Function Name: ia_audio_report
+ ********************************************************************************
+ * Summary:
+ * Writes the capture counters and the per-block processing time histogram.
+ *
+ * Return:
+ *  int - Report length
+ *******************************************************************************/
+int ia_audio_report(char *buffer, size_t buffer_size)
+{
+    audio_capture_stats_t stats = capture_stats;
+    int len = report_append(buffer, buffer_size, 0, "=== AUDIO (bloques de %d muestras, %lu us) ===\n",
+                            AUDIO_BUFFER_SIZE, (unsigned long)AUDIO_BLOCK_US);
+
+    len = report_append(buffer, buffer_size, len,
+                        "bloques=%lu procesados=%lu perdidos=%lu desbordes_fifo=%lu "
+                        "errores_dma=%lu reinicios=%lu\n",
+                        (unsigned long)stats.blocks, (unsigned long)stats.processed,
+                        (unsigned long)stats.overruns, (unsigned long)stats.fifo_overflows,
+                        (unsigned long)stats.dma_errors, (unsigned long)stats.restarts);
+#if defined(IMAI_FRONTEND_CHECK)
+    len = report_append(buffer, buffer_size, len,
+                        "front-end %s: %s error=%.2e ln=%.2e log-mel=%.2e ciclos/trama ref=%lu %s=%lu\n",
+                        frontend_check.variant,
+                        frontend_check.failed_features == 0 ? "ok" : "FUERA DE TOLERANCIA",
+                        frontend_check.max_rel_error, frontend_check.max_log_error,
+                        frontend_check.max_abs_error, (unsigned long)frontend_check.ref_cycles,
+                        frontend_check.variant, (unsigned long)frontend_check.fast_cycles);
+#endif
+    return histogram_report(&process_us, "procesamiento", "us", buffer, buffer_size, len);
+}
+
+/*******************************************************************************
+ * Function Name: ia_arena_report
+ ********************************************************************************
+ * Summary:
+ * Writes the IA arena plan: pool, peak and each region with its phases.
+ *
+ * Return:
+ *  int - Report length
+ *******************************************************************************/
+int ia_arena_report(char *buffer, size_t buffer_size)
+{
+    return arena_report(&ia_arena, buffer, buffer_size);
+}
+
 /*******************************************************************************
  * Static Functions Implementation
  *******************************************************************************/
 
+/*******************************************************************************
+ * Function Name: start_audio_capture
+ ********************************************************************************
+ * Summary:
+ * Empties the PDM FIFO and starts the first DMA transfer into buffer 0.
+ *******************************************************************************/
+static cy_rslt_t start_audio_capture(cyhal_pdm_pcm_t *pdm_pcm)
+{
+    cy_rslt_t result;
+
+    dma_buffer = 0;
+    task_buffer = -1;
+
+    result = cyhal_pdm_pcm_clear(pdm_pcm);
+    if (result != CY_RSLT_SUCCESS)
+    {
+        return result;
+    }
+
+    return cyhal_pdm_pcm_read_async(pdm_pcm, audio_buffers[0], AUDIO_BUFFER_SIZE);
+}
+
+/*******************************************************************************
+ * Function Name: pdm_event_callback
+ ********************************************************************************
+ * Summary:
+ * PDM/PCM interrupt callback. On each completed block it re-arms the DMA on
+ * the other buffer and hands the full one to the IA task. If the task still
+ * holds the other buffer, the block just captured is dropped and counted.
+ *******************************************************************************/
+static void pdm_event_callback(void *arg, cyhal_pdm_pcm_event_t event)
+{
+    cyhal_pdm_pcm_t *pdm_pcm = (cyhal_pdm_pcm_t *)arg;
+    BaseType_t woken = pdFALSE;
+
+    TRACE_ISR_ENTER(TRACE_ISR_PDM);
+
+    if (event & CYHAL_PDM_PCM_RX_OVERFLOW)
+    {
+        capture_stats.fifo_overflows++;
+    }
+
+    if (event & CYHAL_PDM_PCM_ASYNC_COMPLETE)
+    {
+        uint8_t full = dma_buffer;
+
+        capture_stats.blocks++;
+        if (task_buffer < 0)
+        {
+            dma_buffer = full ^ 1u;
+        }
+        else
+        {
+            capture_stats.overruns++; // El DMA reescribe el bloque recién capturado
+        }
+
+        if (cyhal_pdm_pcm_read_async(pdm_pcm, audio_buffers[dma_buffer], AUDIO_BUFFER_SIZE) != CY_RSLT_SUCCESS)
+        {
+            capture_stats.dma_errors++; // La tarea relanza la captura al vencer su espera
+        }
+
+        if (dma_buffer != full)
+        {
+            task_buffer = (int8_t)full;
+            xTaskNotifyFromISR(ia_task_handle, full, eSetValueWithOverwrite, &woken);
+        }
+    }
+
+    TRACE_ISR_EXIT(TRACE_ISR_PDM);
+    portYIELD_FROM_ISR(woken);
+}
+
 /*******************************************************************************
  * Function Name: configure_audio_clocks
  ********************************************************************************
@@ -454,26 +691,3 @@ static void pdm_frequency_fix(void)
 
     *pdm_reg = pdm_data;
 }
-
-/*******************************************************************************
- * Function Name: normalize_and_boost_sample
- ********************************************************************************
- * Summary:
- * Normalizes and applies digital boost to audio sample.
- *******************************************************************************/
-static float normalize_and_boost_sample(int16_t sample)
-{
-    float normalized = SAMPLE_NORMALIZE(sample) * DIGITAL_BOOST_FACTOR;
-
-    /* Clip to valid range */
-    if (normalized > 1.0f)
-    {
-        normalized = 1.0f;
-    }
-    else if (normalized < -1.0f)
-    {
-        normalized = -1.0f;
-    }
-
-    return normalized;
-}
\ No newline at end of file
@@ -3,6 +3,8 @@
 
 #include "cyhal.h"
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 
 /*******************************************************************************
 * Structures
@@ -16,6 +18,16 @@ typedef struct {
     bool detection_active;
 } ml_result_t;
 
+// Contadores de la captura por DMA (los actualiza el callback del PDM)
+typedef struct {
+    uint32_t blocks;         // Bloques completados por el DMA
+    uint32_t processed;      // Bloques procesados por la tarea
+    uint32_t overruns;       // Bloques descartados: la tarea seguía con el anterior
+    uint32_t fifo_overflows; // Desbordes de la FIFO del PDM (muestras perdidas en hardware)
+    uint32_t dma_errors;     // Fallos al relanzar el DMA desde el callback
+    uint32_t restarts;       // Capturas relanzadas por la tarea tras AUDIO_CAPTURE_TIMEOUT_MS
+} audio_capture_stats_t;
+
 /*******************************************************************************
 * Function Prototypes
 *******************************************************************************/
@@ -26,11 +38,17 @@ cy_rslt_t init_audio_system(cyhal_pdm_pcm_t* pdm_pcm);
 cy_rslt_t init_ml_model(void);
 
 /* Audio processing functions */
-cy_rslt_t process_audio_buffer(cyhal_pdm_pcm_t* pdm_pcm, ml_result_t* result);
+cy_rslt_t process_audio_buffer(const int16_t* audio_buffer, size_t audio_count, ml_result_t* result);
 bool check_ml_trigger(ml_result_t* result);
 
 /* Utility functions */
 void print_ml_results(ml_result_t* result);
 void cleanup_audio_system(cyhal_pdm_pcm_t* pdm_pcm);
 
+/* Diagnostics: counters and processing time per block (comando AUDIO) */
+int ia_audio_report(char* buffer, size_t buffer_size);
+
+/* Diagnostics: plan de la arena de la tarea IA (comando ARENA) */
+int ia_arena_report(char* buffer, size_t buffer_size);
+
 #endif /* IA_TASK_H_ */
\ No newline at end of file
@@ -0,0 +1,146 @@
+#include "cyhal.h"
+#include <FreeRTOS.h>
+#include <task.h>
+#include "latency_monitor.h"
+#include "histogram.h"
+#include "report.h"
+
+// Nombre de la etapa que termina en cada marca (la 0 no tiene etapa previa)
+static const char *const stage_names[LATENCY_STAMP_COUNT] = {
+    "recv",
+    "parse",
+    "cola_ctrl",
+    "lookup",
+    "gpio",
+    "respuesta",
+    "cola_resp",
+    "envio",
+};
+
+static histogram_t stage_us[LATENCY_STAMP_COUNT];
+static histogram_t actuation_us;
+static histogram_t total_us;
+static bool initialized = false;
+
+static void reset_histograms(void)
+{
+    for (int i = 0; i < LATENCY_STAMP_COUNT; i++)
+    {
+        histogram_reset(&stage_us[i]);
+    }
+    histogram_reset(&actuation_us);
+    histogram_reset(&total_us);
+    initialized = true;
+}
+
+// Última marca presente antes de 'stage' (LATENCY_RECV siempre está)
+static uint32_t previous_stamp(const message_t *msg, int stage)
+{
+    for (int i = stage - 1; i > LATENCY_RECV; i--)
+    {
+        if (msg->stamps[i] != 0)
+        {
+            return msg->stamps[i];
+        }
+    }
+    return msg->stamps[LATENCY_RECV];
+}
+
+static int last_stage(const message_t *msg)
+{
+    for (int i = LATENCY_STAMP_COUNT - 1; i > LATENCY_RECV; i--)
+    {
+        if (msg->stamps[i] != 0)
+        {
+            return i;
+        }
+    }
+    return LATENCY_RECV;
+}
+
+void latency_monitor_record(const message_t *msg)
+{
+    if (msg->stamps[LATENCY_RECV] == 0)
+    {
+        return;
+    }
+
+    uint32_t recv = msg->stamps[LATENCY_RECV];
+    int last = last_stage(msg);
+
+    // Varias tareas de cliente registran a la vez
+    taskENTER_CRITICAL();
+    if (!initialized)
+    {
+        reset_histograms();
+    }
+
+    for (int i = LATENCY_RECV + 1; i < LATENCY_STAMP_COUNT; i++)
+    {
+        if (msg->stamps[i] != 0)
+        {
+            histogram_record(&stage_us[i], cycles_to_us(msg->stamps[i] - previous_stamp(msg, i)));
+        }
+    }
+    if (msg->stamps[LATENCY_GPIO] != 0)
+    {
+        histogram_record(&actuation_us, cycles_to_us(msg->stamps[LATENCY_GPIO] - recv));
+    }
+    histogram_record(&total_us, cycles_to_us(msg->stamps[last] - recv));
+    taskEXIT_CRITICAL();
+}
+
+int latency_monitor_format(const message_t *msg, char *buffer, size_t buffer_size, int len)
+{
+    if (msg->stamps[LATENCY_RECV] == 0)
+    {
+        return len;
+    }
+
+    uint32_t recv = msg->stamps[LATENCY_RECV];
+    int last = last_stage(msg);
+
+    len = report_append(buffer, buffer_size, len, " [us");
+    if (msg->stamps[LATENCY_GPIO] != 0)
+    {
+        len = report_append(buffer, buffer_size, len, " recv>gpio=%lu",
+                            (unsigned long)cycles_to_us(msg->stamps[LATENCY_GPIO] - recv));
+    }
+    len = report_append(buffer, buffer_size, len, " total=%lu |",
+                        (unsigned long)cycles_to_us(msg->stamps[last] - recv));
+
+    for (int i = LATENCY_RECV + 1; i <= last; i++)
+    {
+        if (msg->stamps[i] != 0)
+        {
+            len = report_append(buffer, buffer_size, len, " %s=%lu", stage_names[i],
+                                (unsigned long)cycles_to_us(msg->stamps[i] - previous_stamp(msg, i)));
+        }
+    }
+    return report_append(buffer, buffer_size, len, "]");
+}
+
+void latency_monitor_reset(void)
+{
+    taskENTER_CRITICAL();
+    reset_histograms();
+    taskEXIT_CRITICAL();
+}
+
+int latency_monitor_report(char *buffer, size_t buffer_size)
+{
+    int len = report_append(buffer, buffer_size, 0, "=== LATENCIA DE COMANDOS ===\n");
+
+    if (!initialized)
+    {
+        return report_append(buffer, buffer_size, len, "sin muestras\n");
+    }
+
+    len = histogram_report(&actuation_us, "recv>gpio", "us", buffer, buffer_size, len);
+    len = histogram_report(&total_us, "total", "us", buffer, buffer_size, len);
+    for (int i = LATENCY_RECV + 1; i < LATENCY_STAMP_COUNT; i++)
+    {
+        len = histogram_report(&stage_us[i], stage_names[i], "us", buffer, buffer_size, len);
+    }
+    return len;
+}
@@ -0,0 +1,29 @@
+#ifndef LATENCY_MONITOR_H_
+#define LATENCY_MONITOR_H_
+
+#include <stddef.h>
+#include "types.h"
+#include "cycle_counter.h"
+
+// Latencia de extremo a extremo de los comandos TCP. Cada etapa marca el
+// mensaje con el contador de ciclos; la respuesta hereda las marcas del
+// comando y al enviarse se agregan a histogramas por etapa, de actuación
+// (recv -> GPIO, el SLA) y total (recv -> respuesta enviada).
+
+static inline void latency_monitor_stamp(message_t *msg, latency_stamp_t stage)
+{
+    msg->stamps[stage] = cycle_counter_now();
+}
+
+// Agrega las marcas de una respuesta ya enviada. Ignora los mensajes sin
+// LATENCY_RECV (comandos por voz).
+void latency_monitor_record(const message_t *msg);
+
+// " [us recv>gpio=... total=... | etapa=...]" para el eco por cliente
+int latency_monitor_format(const message_t *msg, char *buffer, size_t buffer_size, int len);
+
+void latency_monitor_reset(void);
+
+int latency_monitor_report(char *buffer, size_t buffer_size);
+
+#endif /* LATENCY_MONITOR_H_ */
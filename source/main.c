@@ -7,8 +7,54 @@
 #include "tcp_server.h"
 #include "ia.h"
 #include "control.h"
+#include "stack_monitor.h"
+#include "heap_monitor.h"
+#include "trace_recorder.h"
+#include "queue_monitor.h"
+#include "cycle_counter.h"
+#include "config.h"
 #include "types.h" // Importante: incluir types.h
 
+#if defined(APP_ZERO_HEAP)
+// Modo sin heap: almacenamiento estático de las tareas, colas y mutex propios
+static StackType_t tcp_stack[TCP_SERVER_TASK_STACK_SIZE];
+static StackType_t ia_stack[IA_TASK_STACK_SIZE];
+static StackType_t control_stack[CONTROL_TASK_STACK_SIZE];
+static StaticTask_t tcp_tcb;
+static StaticTask_t ia_tcb;
+static StaticTask_t control_tcb;
+static uint8_t queue_storage[3][MESSAGE_QUEUE_LENGTH * sizeof(message_t)];
+static StaticQueue_t queue_structs[3];
+static StaticSemaphore_t mutex_struct;
+#define TASK_STORAGE(stack, tcb) (stack), &(tcb)
+#else
+#define TASK_STORAGE(stack, tcb) NULL, NULL
+#endif
+
+static QueueHandle_t create_message_queue(int index)
+{
+#if defined(APP_ZERO_HEAP)
+    return xQueueCreateStatic(MESSAGE_QUEUE_LENGTH, sizeof(message_t),
+                              queue_storage[index], &queue_structs[index]);
+#else
+    return xQueueCreate(MESSAGE_QUEUE_LENGTH, sizeof(message_t));
+#endif
+}
+
+static BaseType_t create_task(TaskFunction_t function, const char *name, uint32_t stack_words,
+                              void *param, UBaseType_t priority,
+                              StackType_t *stack, StaticTask_t *tcb, TaskHandle_t *handle)
+{
+#if defined(APP_ZERO_HEAP)
+    *handle = xTaskCreateStatic(function, name, stack_words, param, priority, stack, tcb);
+    return (*handle != NULL) ? pdPASS : pdFAIL;
+#else
+    (void)stack;
+    (void)tcb;
+    return xTaskCreate(function, name, stack_words, param, priority, handle);
+#endif
+}
+
 int main(void)
 {
     cy_rslt_t result;
@@ -20,9 +66,20 @@ int main(void)
     // Step 2: Enable interrupts
     __enable_irq();
 
+    // Regiones de heap_5: antes de cualquier objeto del kernel
+    heap_monitor_init();
+
+    // Marcas de tiempo de colas y latencia
+    cycle_counter_init();
+
+#if defined(APP_TRACE_RECORDER)
+    trace_recorder_init();
+#endif
+
     // Step 3: Initialize debug UART
     cy_retarget_io_init(CYBSP_DEBUG_UART_TX, CYBSP_DEBUG_UART_RX,
                         CY_RETARGET_IO_BAUDRATE);
+    heap_monitor_log_regions();
 
     // Step 4: Create queues and mutex
     QueueHandle_t Buzon_ia_to_tcp;      // IA Task -> TCP Server
@@ -30,10 +87,14 @@ int main(void)
     QueueHandle_t Buzon_control_to_tcp; // Control -> TCP Server
     SemaphoreHandle_t mutex_datos_compartidos;
 
-    Buzon_ia_to_tcp = xQueueCreate(20, sizeof(message_t));
-    Buzon_tcp_to_control = xQueueCreate(20, sizeof(message_t));
-    Buzon_control_to_tcp = xQueueCreate(20, sizeof(message_t));
+    Buzon_ia_to_tcp = create_message_queue(0);
+    Buzon_tcp_to_control = create_message_queue(1);
+    Buzon_control_to_tcp = create_message_queue(2);
+#if defined(APP_ZERO_HEAP)
+    mutex_datos_compartidos = xSemaphoreCreateMutexStatic(&mutex_struct);
+#else
     mutex_datos_compartidos = xSemaphoreCreateMutex();
+#endif
 
     // Verificar que las colas se crearon correctamente
     if (!Buzon_ia_to_tcp || !Buzon_tcp_to_control || !Buzon_control_to_tcp || !mutex_datos_compartidos)
@@ -41,6 +102,7 @@ int main(void)
         printf("ERROR: No se pudieron crear las colas de comunicación\n");
         CY_ASSERT(0);
     }
+    TRACE_NAME_QUEUE(mutex_datos_compartidos, "mutex_datos");
     printf("\x1b[0m"); 
     printf("\x1b[1m");  // Negrita
     printf("      ___           ___                       ___           ___           ___     \n");
@@ -57,36 +119,43 @@ int main(void)
     printf("\x1b[22m");
     // Crear estructura de parámetros para las tareas
     static task_params_t task_params = {0}; // Static para que persista
-    task_params.queue_tcp_to_control = Buzon_tcp_to_control;
-    task_params.queue_control_to_tcp = Buzon_control_to_tcp;
-    task_params.queue_ia_to_tcp = Buzon_ia_to_tcp;
+    task_params.queue_tcp_to_control = queue_monitor_register(Buzon_tcp_to_control, "tcp_to_control", MESSAGE_QUEUE_LENGTH);
+    task_params.queue_control_to_tcp = queue_monitor_register(Buzon_control_to_tcp, "control_to_tcp", MESSAGE_QUEUE_LENGTH);
+    task_params.queue_ia_to_tcp = queue_monitor_register(Buzon_ia_to_tcp, "ia_to_tcp", MESSAGE_QUEUE_LENGTH);
 
     // Step 5: Create tasks with parameters
-    BaseType_t task_result = xTaskCreate(
-        tarea_TCPserver, // Task function
-        "TCP_Server",    // Task name
-        (1024 * 5),      // 5KB Stack size
-        &task_params,    // Parameters - IMPORTANTE: pasar los parámetros
-        (3),             // Priority
-        NULL             // Task handle (not needed)
+    TaskHandle_t tcp_handle = NULL;
+    TaskHandle_t ia_handle = NULL;
+    TaskHandle_t control_handle = NULL;
+
+    BaseType_t task_result = create_task(
+        tarea_TCPserver,                      // Task function
+        "TCP_Server",                         // Task name
+        TCP_SERVER_TASK_STACK_SIZE,           // Stack size (palabras)
+        &task_params,                         // Parameters - IMPORTANTE: pasar los parámetros
+        (3),                                  // Priority
+        TASK_STORAGE(tcp_stack, tcp_tcb),     // Pila y TCB estáticos (APP_ZERO_HEAP)
+        &tcp_handle                           // Task handle (monitoreo de pila)
     );
 
-    BaseType_t task_result2 = xTaskCreate(
-        tarea_ia,     // Task function
-        "IA_Task",    // Task name
-        (1024 * 50),  // 50KB Stack size
-        &task_params, // Parameters - IMPORTANTE: pasar los parámetros
-        (2),          // Priority
-        NULL          // Task handle (not needed)
+    BaseType_t task_result2 = create_task(
+        tarea_ia,                             // Task function
+        "IA_Task",                            // Task name
+        IA_TASK_STACK_SIZE,                   // Stack size (palabras)
+        &task_params,                         // Parameters - IMPORTANTE: pasar los parámetros
+        (2),                                  // Priority
+        TASK_STORAGE(ia_stack, ia_tcb),       // Pila y TCB estáticos (APP_ZERO_HEAP)
+        &ia_handle                            // Task handle (monitoreo de pila)
     );
 
-    BaseType_t task_result3 = xTaskCreate(
-        control,      // Task function
-        "Controlpin", // Task name
-        (1024 * 2),   // 2KB Stack size
-        &task_params, // Parameters - IMPORTANTE: pasar los parámetros
-        (1),          // Priority
-        NULL          // Task handle (not needed)
+    BaseType_t task_result3 = create_task(
+        control,                              // Task function
+        "Controlpin",                         // Task name
+        CONTROL_TASK_STACK_SIZE,              // Stack size (palabras)
+        &task_params,                         // Parameters - IMPORTANTE: pasar los parámetros
+        (1),                                  // Priority
+        TASK_STORAGE(control_stack, control_tcb), // Pila y TCB estáticos (APP_ZERO_HEAP)
+        &control_handle                       // Task handle (monitoreo de pila)
     );
 
     // Check task creation
@@ -103,6 +172,16 @@ int main(void)
         printf("Todas las tareas creadas exitosamente\n");
     }
 
+    // Registrar tareas de larga vida para el monitoreo de pilas
+    stack_monitor_register("TCP_Server", TCP_SERVER_TASK_STACK_SIZE, tcp_handle);
+    stack_monitor_register("IA_Task", IA_TASK_STACK_SIZE, ia_handle);
+    stack_monitor_register("Controlpin", CONTROL_TASK_STACK_SIZE, control_handle);
+
+    // Tareas que no deben asignar memoria en régimen permanente
+    heap_monitor_watch_task(tcp_handle);
+    heap_monitor_watch_task(ia_handle);
+    heap_monitor_watch_task(control_handle);
+
     // Step 6: Start scheduler
     vTaskStartScheduler();
 
@@ -62,6 +62,7 @@
 #include "mtb_ml.h"
 
 #include "model1audio.h"
+#include "model1audio_frontend.h" // Hand-written hook (README.md)
 
 #ifdef __GNUC__
 #define ALIGNED(x) __attribute__((aligned(x)))
@@ -70,8 +71,10 @@
 #endif
 
 // Working memory
+#if !defined(IMAI_FRONTEND_HANDWRITTEN) // Hand-written hook (README.md)
 static ALIGNED(16) int8_t _buffer[10256];
 static ALIGNED(16) int8_t _state[25992];
+#endif
 
 // Parameters
 static const ALIGNED(16) uint32_t _K7[] = {
@@ -6533,6 +6536,9 @@ int mtb_init(const void *handle, uint8_t* model_bin, unsigned int model_size, ui
 #define __RETURN_ERROR_CANCEL_EMPTY(_exp) {  int __ret = (_exp); if(__ret == -1) return 0; if(__ret < 0) return __ret; }
 #define __BREAK_ERROR(_exp) {  int __ret = (_exp); if(__ret < 0) break; }
 
+#if defined(IMAI_FRONTEND_HANDWRITTEN) // Hand-written hook (README.md)
+#include "model1audio_frontend.inc"
+#else
 /*
 * Try read data from model.
 * 
@@ -6586,6 +6592,8 @@ int IMAI_init(void) {
     return 0;
 }
 
+#endif
+
 #ifdef IMAI_REFLECTION
 
 static IMAI_api_def _IMAI_api_def = {
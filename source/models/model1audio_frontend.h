@@ -0,0 +1,54 @@
+#ifndef MODEL1AUDIO_FRONTEND_H_
+#define MODEL1AUDIO_FRONTEND_H_
+
+// Hand-written extensions of the DEEPCRAFT export (not generated): block
+// ingest, caller-placed memory and the front-end variants. Include after
+// model1audio.h. The implementation is model1audio_frontend.inc, included by
+// model1audio.c in place of the generated IMAI_* bodies; see README.md for
+// the steps after a re-export.
+
+#include <stdint.h>
+
+// Selects the hand-written implementation in model1audio.c
+#define IMAI_FRONTEND_HANDWRITTEN
+
+// Block ingest
+int IMAI_enqueue_block(const int16_t *restrict samples, int count, float boost, float *restrict data_out);
+
+// Memory placed by the caller
+#define IMAI_SCRATCH_SIZE 8208     // Front-end scratch, live only while a hop is processed
+#define IMAI_TFLM_ARENA_SIZE 16384 // TFLM tensor arena
+void IMAI_set_arena(int8_t *scratch, uint8_t *tflm_arena);
+#if defined(APP_SHARED_ARENA)
+int IMAI_arena_check(void);
+#endif
+
+#if defined(APP_FRONTEND_CMSIS_FFT) || defined(APP_FRONTEND_FUSED) || defined(APP_FRONTEND_Q15)
+// Front-end self-check: the configured front-end variant against the
+// generated path on synthetic frames, mel energies, log-mel features and
+// cycles per frame
+#define IMAI_FRONTEND_CHECK
+#define IMAI_FRONTEND_CHECK_FRAMES 8
+#if defined(APP_FRONTEND_Q15)
+#define IMAI_FRONTEND_CHECK_TOLERANCE 1e-4f // Q31 FFT and magnitude, Q15 mel weights
+#define IMAI_FRONTEND_LOG_TOLERANCE 1e-5f   // Max |table ln - logf| on the reference energies
+#else
+#define IMAI_FRONTEND_CHECK_TOLERANCE 1e-5f // Max mel energy error / largest band of the frame
+#define IMAI_FRONTEND_LOG_TOLERANCE 1e-5f   // Max |fast ln - logf| on the reference energies
+#endif
+
+typedef struct {
+    const char *variant;    // "cmsis", "fused", "cmsis+fused" or "q15"
+    int frames;
+    int failed_features;    // Bands above either tolerance
+    float max_rel_error;    // Mel energy, relative to the frame's largest band
+    float max_log_error;    // Fast or table ln alone (APP_FRONTEND_FUSED, APP_FRONTEND_Q15)
+    float max_abs_error;    // Log-mel feature (informative)
+    uint32_t ref_cycles;    // Per frame, generated path
+    uint32_t fast_cycles;   // Per frame, configured variant
+} IMAI_frontend_check_t;
+
+int IMAI_frontend_check(uint32_t (*cycles)(void), IMAI_frontend_check_t *report);
+#endif
+
+#endif /* MODEL1AUDIO_FRONTEND_H_ */
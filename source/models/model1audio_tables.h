@@ -0,0 +1,350 @@
+#ifndef MODEL1AUDIO_TABLES_H_
+#define MODEL1AUDIO_TABLES_H_
+
+// Generado por tools/gen_frontend_tables.py a partir de model1audio.c; no editar.
+
+// rdft de 512 puntos: ip = {nw, nc, bit-reversal}, w = nw twiddles y nc cosenos
+#define FFT512_NW 128
+#define FFT512_NC 128
+
+static const int32_t fft512_ip[8] = {128, 128, 0, 16, 0, 64, 32, 96};
+
+static const float fft512_w[FFT512_NW + FFT512_NC] = {
+    1.000000000e+00f, 7.071067691e-01f, 5.001506209e-01f, 5.013584495e-01f,
+    9.987954497e-01f, 4.906767607e-02f, 9.891765118e-01f, -1.467304677e-01f,
+    9.951847196e-01f, 9.801714122e-02f, 9.569403529e-01f, -2.902846634e-01f,
+    9.891765118e-01f, 1.467304677e-01f, 9.039893150e-01f, -4.275550842e-01f,
+    9.807852507e-01f, 1.950903237e-01f, 8.314695954e-01f, -5.555702448e-01f,
+    9.700312614e-01f, 2.429801971e-01f, 7.409511209e-01f, -6.715589762e-01f,
+    9.569403529e-01f, 2.902846634e-01f, 6.343932748e-01f, -7.730104327e-01f,
+    9.415440559e-01f, 3.368898630e-01f, 5.141026974e-01f, -8.577286601e-01f,
+    9.238795042e-01f, 3.826834559e-01f, 3.826834261e-01f, -9.238795042e-01f,
+    9.039893150e-01f, 4.275550842e-01f, 2.429802418e-01f, -9.700312614e-01f,
+    8.819212317e-01f, 4.713967443e-01f, 9.801713377e-02f, -9.951847196e-01f,
+    8.577286005e-01f, 5.141027570e-01f, -4.906773940e-02f, -9.987954497e-01f,
+    8.314695954e-01f, 5.555702448e-01f, -1.950903237e-01f, -9.807852507e-01f,
+    8.032075167e-01f, 5.956993103e-01f, -3.368898034e-01f, -9.415440559e-01f,
+    7.730104327e-01f, 6.343933344e-01f, -4.713968337e-01f, -8.819212317e-01f,
+    7.409511209e-01f, 6.715589762e-01f, -5.956993699e-01f, -8.032075167e-01f,
+    1.000000000e+00f, 7.071067691e-01f, 5.006030202e-01f, 5.054709315e-01f,
+    9.951847196e-01f, 9.801714122e-02f, 9.569403529e-01f, -2.902846634e-01f,
+    9.807852507e-01f, 1.950903237e-01f, 8.314695954e-01f, -5.555702448e-01f,
+    9.569403529e-01f, 2.902846634e-01f, 6.343932748e-01f, -7.730104327e-01f,
+    9.238795042e-01f, 3.826834559e-01f, 3.826834261e-01f, -9.238795042e-01f,
+    8.819212317e-01f, 4.713967443e-01f, 9.801713377e-02f, -9.951847196e-01f,
+    8.314695954e-01f, 5.555702448e-01f, -1.950903237e-01f, -9.807852507e-01f,
+    7.730104327e-01f, 6.343933344e-01f, -4.713968337e-01f, -8.819212317e-01f,
+    1.000000000e+00f, 7.071067691e-01f, 5.024192929e-01f, 5.224986076e-01f,
+    9.807852507e-01f, 1.950903237e-01f, 8.314695954e-01f, -5.555702448e-01f,
+    9.238795042e-01f, 3.826834559e-01f, 3.826834261e-01f, -9.238795042e-01f,
+    8.314695954e-01f, 5.555702448e-01f, -1.950903237e-01f, -9.807852507e-01f,
+    1.000000000e+00f, 7.071067691e-01f, 5.097956061e-01f, 6.013448834e-01f,
+    9.238795042e-01f, 3.826834559e-01f, 3.826834261e-01f, -9.238795042e-01f,
+    1.000000000e+00f, 7.071067691e-01f, 9.238795042e-01f, 3.826834559e-01f,
+    1.000000000e+00f, 7.071067691e-01f, 0.000000000e+00f, 0.000000000e+00f,
+    7.071067691e-01f, 4.999623597e-01f, 4.998494089e-01f, 4.996611774e-01f,
+    4.993977249e-01f, 4.990590513e-01f, 4.986452162e-01f, 4.981563091e-01f,
+    4.975923598e-01f, 4.969534874e-01f, 4.962397814e-01f, 4.954513311e-01f,
+    4.945882559e-01f, 4.936507046e-01f, 4.926388264e-01f, 4.915527403e-01f,
+    4.903926253e-01f, 4.891586900e-01f, 4.878510535e-01f, 4.864699841e-01f,
+    4.850156307e-01f, 4.834882319e-01f, 4.818880260e-01f, 4.802152514e-01f,
+    4.784701765e-01f, 4.766530097e-01f, 4.747640789e-01f, 4.728036523e-01f,
+    4.707720280e-01f, 4.686695039e-01f, 4.664964080e-01f, 4.642530382e-01f,
+    4.619397521e-01f, 4.595569372e-01f, 4.571048617e-01f, 4.545839727e-01f,
+    4.519946575e-01f, 4.493372440e-01f, 4.466121495e-01f, 4.438198209e-01f,
+    4.409606159e-01f, 4.380350411e-01f, 4.350434840e-01f, 4.319864213e-01f,
+    4.288643003e-01f, 4.256775975e-01f, 4.224267900e-01f, 4.191123545e-01f,
+    4.157347977e-01f, 4.122946262e-01f, 4.087924063e-01f, 4.052285850e-01f,
+    4.016037583e-01f, 3.979184628e-01f, 3.941732049e-01f, 3.903686106e-01f,
+    3.865052164e-01f, 3.825836182e-01f, 3.786044121e-01f, 3.745681942e-01f,
+    3.704755604e-01f, 3.663271368e-01f, 3.621235490e-01f, 3.578653932e-01f,
+    3.535533845e-01f, 3.491881490e-01f, 3.447702825e-01f, 3.403005004e-01f,
+    3.357794881e-01f, 3.312079012e-01f, 3.265864253e-01f, 3.219157755e-01f,
+    3.171966672e-01f, 3.124297559e-01f, 3.076158166e-01f, 3.027555048e-01f,
+    2.978496552e-01f, 2.928989530e-01f, 2.879041135e-01f, 2.828659117e-01f,
+    2.777851224e-01f, 2.726624906e-01f, 2.674988210e-01f, 2.622948587e-01f,
+    2.570513785e-01f, 2.517691851e-01f, 2.464491129e-01f, 2.410918772e-01f,
+    2.356983721e-01f, 2.302693576e-01f, 2.248056680e-01f, 2.193081230e-01f,
+    2.137775421e-01f, 2.082147896e-01f, 2.026206702e-01f, 1.969960332e-01f,
+    1.913417280e-01f, 1.856586039e-01f, 1.799475253e-01f, 1.742093414e-01f,
+    1.684449315e-01f, 1.626551598e-01f, 1.568408757e-01f, 1.510029733e-01f,
+    1.451423317e-01f, 1.392598450e-01f, 1.333563924e-01f, 1.274328381e-01f,
+    1.214900985e-01f, 1.155290604e-01f, 1.095506176e-01f, 1.035556942e-01f,
+    9.754516184e-02f, 9.151994437e-02f, 8.548095077e-02f, 7.942907512e-02f,
+    7.336523384e-02f, 6.729035825e-02f, 6.120533869e-02f, 5.511110276e-02f,
+    4.900857061e-02f, 4.289865866e-02f, 3.678228334e-02f, 3.066037036e-02f,
+    2.453383803e-02f, 1.840361208e-02f, 1.227061450e-02f, 6.135769188e-03f,
+};
+
+// Tensores del modelo (_K7): entrada float32 [1, 50, 30], salida float32 [1, 2]
+#define MODEL_INPUT_INT8 0
+#define MODEL_OUTPUT_INT8 0
+
+#if defined(APP_FRONTEND_FUSED) || defined(APP_FRONTEND_Q15)
+// Filtros mel: puntos 6, 8, 10, 13, 15, 18, 21, 24, 27, 31, 35, 39, 43, 48, 53, 59, 64, 71, 77, 85, 92, 101, 109, 119, 129, 140, 152, 164, 178, 192, 207, 224
+#define MEL_FIRST_BIN 6
+#define MEL_TABLE_BINS 218
+#define MEL_SEGMENTS 31 // El segmento s sube la banda s y baja la s - 1
+
+static const uint8_t mel_segment[MEL_TABLE_BINS] = {
+    0, 0, 1, 1, 2, 2, 2, 3, 3, 4, 4, 4, 5, 5, 5, 6,
+    6, 6, 7, 7, 7, 8, 8, 8, 8, 9, 9, 9, 9, 10, 10, 10,
+    10, 11, 11, 11, 11, 12, 12, 12, 12, 12, 13, 13, 13, 13, 13, 14,
+    14, 14, 14, 14, 14, 15, 15, 15, 15, 15, 16, 16, 16, 16, 16, 16,
+    16, 17, 17, 17, 17, 17, 17, 18, 18, 18, 18, 18, 18, 18, 18, 19,
+    19, 19, 19, 19, 19, 19, 20, 20, 20, 20, 20, 20, 20, 20, 20, 21,
+    21, 21, 21, 21, 21, 21, 21, 22, 22, 22, 22, 22, 22, 22, 22, 22,
+    22, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 24, 24, 24, 24, 24,
+    24, 24, 24, 24, 24, 24, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25,
+    25, 25, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 27, 27,
+    27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 28, 28, 28, 28,
+    28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 29, 29, 29, 29, 29, 29,
+    29, 29, 29, 29, 29, 29, 29, 29, 29, 30, 30, 30, 30, 30, 30, 30,
+    30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+};
+#endif
+
+#if defined(APP_FRONTEND_FUSED)
+typedef struct {
+    float rise; // Peso en la banda del segmento
+    float fall; // Peso en la banda anterior
+} mel_weight_t;
+
+static const mel_weight_t mel_weight[MEL_TABLE_BINS] = {
+    {0.000000000e+00f, 1.000000000e+00f}, {5.000000000e-01f, 5.000000000e-01f}, {0.000000000e+00f, 1.000000000e+00f},
+    {5.000000000e-01f, 5.000000000e-01f}, {0.000000000e+00f, 1.000000000e+00f}, {3.333333433e-01f, 6.666666269e-01f},
+    {6.666666865e-01f, 3.333333135e-01f}, {0.000000000e+00f, 1.000000000e+00f}, {5.000000000e-01f, 5.000000000e-01f},
+    {0.000000000e+00f, 1.000000000e+00f}, {3.333333433e-01f, 6.666666269e-01f}, {6.666666865e-01f, 3.333333135e-01f},
+    {0.000000000e+00f, 1.000000000e+00f}, {3.333333433e-01f, 6.666666269e-01f}, {6.666666865e-01f, 3.333333135e-01f},
+    {0.000000000e+00f, 1.000000000e+00f}, {3.333333433e-01f, 6.666666269e-01f}, {6.666666865e-01f, 3.333333135e-01f},
+    {0.000000000e+00f, 1.000000000e+00f}, {3.333333433e-01f, 6.666666269e-01f}, {6.666666865e-01f, 3.333333135e-01f},
+    {0.000000000e+00f, 1.000000000e+00f}, {2.500000000e-01f, 7.500000000e-01f}, {5.000000000e-01f, 5.000000000e-01f},
+    {7.500000000e-01f, 2.500000000e-01f}, {0.000000000e+00f, 1.000000000e+00f}, {2.500000000e-01f, 7.500000000e-01f},
+    {5.000000000e-01f, 5.000000000e-01f}, {7.500000000e-01f, 2.500000000e-01f}, {0.000000000e+00f, 1.000000000e+00f},
+    {2.500000000e-01f, 7.500000000e-01f}, {5.000000000e-01f, 5.000000000e-01f}, {7.500000000e-01f, 2.500000000e-01f},
+    {0.000000000e+00f, 1.000000000e+00f}, {2.500000000e-01f, 7.500000000e-01f}, {5.000000000e-01f, 5.000000000e-01f},
+    {7.500000000e-01f, 2.500000000e-01f}, {0.000000000e+00f, 1.000000000e+00f}, {2.000000030e-01f, 8.000000119e-01f},
+    {4.000000060e-01f, 6.000000238e-01f}, {6.000000238e-01f, 3.999999762e-01f}, {8.000000119e-01f, 1.999999881e-01f},
+    {0.000000000e+00f, 1.000000000e+00f}, {2.000000030e-01f, 8.000000119e-01f}, {4.000000060e-01f, 6.000000238e-01f},
+    {6.000000238e-01f, 3.999999762e-01f}, {8.000000119e-01f, 1.999999881e-01f}, {0.000000000e+00f, 1.000000000e+00f},
+    {1.666666716e-01f, 8.333333135e-01f}, {3.333333433e-01f, 6.666666269e-01f}, {5.000000000e-01f, 5.000000000e-01f},
+    {6.666666865e-01f, 3.333333135e-01f}, {8.333333135e-01f, 1.666666865e-01f}, {0.000000000e+00f, 1.000000000e+00f},
+    {2.000000030e-01f, 8.000000119e-01f}, {4.000000060e-01f, 6.000000238e-01f}, {6.000000238e-01f, 3.999999762e-01f},
+    {8.000000119e-01f, 1.999999881e-01f}, {0.000000000e+00f, 1.000000000e+00f}, {1.428571492e-01f, 8.571428657e-01f},
+    {2.857142985e-01f, 7.142857313e-01f}, {4.285714328e-01f, 5.714285374e-01f}, {5.714285970e-01f, 4.285714030e-01f},
+    {7.142857313e-01f, 2.857142687e-01f}, {8.571428657e-01f, 1.428571343e-01f}, {0.000000000e+00f, 1.000000000e+00f},
+    {1.666666716e-01f, 8.333333135e-01f}, {3.333333433e-01f, 6.666666269e-01f}, {5.000000000e-01f, 5.000000000e-01f},
+    {6.666666865e-01f, 3.333333135e-01f}, {8.333333135e-01f, 1.666666865e-01f}, {0.000000000e+00f, 1.000000000e+00f},
+    {1.250000000e-01f, 8.750000000e-01f}, {2.500000000e-01f, 7.500000000e-01f}, {3.750000000e-01f, 6.250000000e-01f},
+    {5.000000000e-01f, 5.000000000e-01f}, {6.250000000e-01f, 3.750000000e-01f}, {7.500000000e-01f, 2.500000000e-01f},
+    {8.750000000e-01f, 1.250000000e-01f}, {0.000000000e+00f, 1.000000000e+00f}, {1.428571492e-01f, 8.571428657e-01f},
+    {2.857142985e-01f, 7.142857313e-01f}, {4.285714328e-01f, 5.714285374e-01f}, {5.714285970e-01f, 4.285714030e-01f},
+    {7.142857313e-01f, 2.857142687e-01f}, {8.571428657e-01f, 1.428571343e-01f}, {0.000000000e+00f, 1.000000000e+00f},
+    {1.111111119e-01f, 8.888888955e-01f}, {2.222222239e-01f, 7.777777910e-01f}, {3.333333433e-01f, 6.666666269e-01f},
+    {4.444444478e-01f, 5.555555820e-01f}, {5.555555820e-01f, 4.444444180e-01f}, {6.666666865e-01f, 3.333333135e-01f},
+    {7.777777910e-01f, 2.222222090e-01f}, {8.888888955e-01f, 1.111111045e-01f}, {0.000000000e+00f, 1.000000000e+00f},
+    {1.250000000e-01f, 8.750000000e-01f}, {2.500000000e-01f, 7.500000000e-01f}, {3.750000000e-01f, 6.250000000e-01f},
+    {5.000000000e-01f, 5.000000000e-01f}, {6.250000000e-01f, 3.750000000e-01f}, {7.500000000e-01f, 2.500000000e-01f},
+    {8.750000000e-01f, 1.250000000e-01f}, {0.000000000e+00f, 1.000000000e+00f}, {1.000000015e-01f, 8.999999762e-01f},
+    {2.000000030e-01f, 8.000000119e-01f}, {3.000000119e-01f, 6.999999881e-01f}, {4.000000060e-01f, 6.000000238e-01f},
+    {5.000000000e-01f, 5.000000000e-01f}, {6.000000238e-01f, 3.999999762e-01f}, {6.999999881e-01f, 3.000000119e-01f},
+    {8.000000119e-01f, 1.999999881e-01f}, {8.999999762e-01f, 1.000000238e-01f}, {0.000000000e+00f, 1.000000000e+00f},
+    {1.000000015e-01f, 8.999999762e-01f}, {2.000000030e-01f, 8.000000119e-01f}, {3.000000119e-01f, 6.999999881e-01f},
+    {4.000000060e-01f, 6.000000238e-01f}, {5.000000000e-01f, 5.000000000e-01f}, {6.000000238e-01f, 3.999999762e-01f},
+    {6.999999881e-01f, 3.000000119e-01f}, {8.000000119e-01f, 1.999999881e-01f}, {8.999999762e-01f, 1.000000238e-01f},
+    {0.000000000e+00f, 1.000000000e+00f}, {9.090909362e-02f, 9.090908766e-01f}, {1.818181872e-01f, 8.181818128e-01f},
+    {2.727272809e-01f, 7.272727489e-01f}, {3.636363745e-01f, 6.363636255e-01f}, {4.545454681e-01f, 5.454545021e-01f},
+    {5.454545617e-01f, 4.545454383e-01f}, {6.363636255e-01f, 3.636363745e-01f}, {7.272727489e-01f, 2.727272511e-01f},
+    {8.181818128e-01f, 1.818181872e-01f}, {9.090909362e-01f, 9.090906382e-02f}, {0.000000000e+00f, 1.000000000e+00f},
+    {8.333333582e-02f, 9.166666865e-01f}, {1.666666716e-01f, 8.333333135e-01f}, {2.500000000e-01f, 7.500000000e-01f},
+    {3.333333433e-01f, 6.666666269e-01f}, {4.166666567e-01f, 5.833333731e-01f}, {5.000000000e-01f, 5.000000000e-01f},
+    {5.833333135e-01f, 4.166666865e-01f}, {6.666666865e-01f, 3.333333135e-01f}, {7.500000000e-01f, 2.500000000e-01f},
+    {8.333333135e-01f, 1.666666865e-01f}, {9.166666865e-01f, 8.333331347e-02f}, {0.000000000e+00f, 1.000000000e+00f},
+    {8.333333582e-02f, 9.166666865e-01f}, {1.666666716e-01f, 8.333333135e-01f}, {2.500000000e-01f, 7.500000000e-01f},
+    {3.333333433e-01f, 6.666666269e-01f}, {4.166666567e-01f, 5.833333731e-01f}, {5.000000000e-01f, 5.000000000e-01f},
+    {5.833333135e-01f, 4.166666865e-01f}, {6.666666865e-01f, 3.333333135e-01f}, {7.500000000e-01f, 2.500000000e-01f},
+    {8.333333135e-01f, 1.666666865e-01f}, {9.166666865e-01f, 8.333331347e-02f}, {0.000000000e+00f, 1.000000000e+00f},
+    {7.142857462e-02f, 9.285714030e-01f}, {1.428571492e-01f, 8.571428657e-01f}, {2.142857164e-01f, 7.857142687e-01f},
+    {2.857142985e-01f, 7.142857313e-01f}, {3.571428657e-01f, 6.428571343e-01f}, {4.285714328e-01f, 5.714285374e-01f},
+    {5.000000000e-01f, 5.000000000e-01f}, {5.714285970e-01f, 4.285714030e-01f}, {6.428571343e-01f, 3.571428657e-01f},
+    {7.142857313e-01f, 2.857142687e-01f}, {7.857142687e-01f, 2.142857313e-01f}, {8.571428657e-01f, 1.428571343e-01f},
+    {9.285714030e-01f, 7.142859697e-02f}, {0.000000000e+00f, 1.000000000e+00f}, {7.142857462e-02f, 9.285714030e-01f},
+    {1.428571492e-01f, 8.571428657e-01f}, {2.142857164e-01f, 7.857142687e-01f}, {2.857142985e-01f, 7.142857313e-01f},
+    {3.571428657e-01f, 6.428571343e-01f}, {4.285714328e-01f, 5.714285374e-01f}, {5.000000000e-01f, 5.000000000e-01f},
+    {5.714285970e-01f, 4.285714030e-01f}, {6.428571343e-01f, 3.571428657e-01f}, {7.142857313e-01f, 2.857142687e-01f},
+    {7.857142687e-01f, 2.142857313e-01f}, {8.571428657e-01f, 1.428571343e-01f}, {9.285714030e-01f, 7.142859697e-02f},
+    {0.000000000e+00f, 1.000000000e+00f}, {6.666667014e-02f, 9.333333373e-01f}, {1.333333403e-01f, 8.666666746e-01f},
+    {2.000000030e-01f, 8.000000119e-01f}, {2.666666806e-01f, 7.333333492e-01f}, {3.333333433e-01f, 6.666666269e-01f},
+    {4.000000060e-01f, 6.000000238e-01f}, {4.666666687e-01f, 5.333333015e-01f}, {5.333333611e-01f, 4.666666389e-01f},
+    {6.000000238e-01f, 3.999999762e-01f}, {6.666666865e-01f, 3.333333135e-01f}, {7.333333492e-01f, 2.666666508e-01f},
+    {8.000000119e-01f, 1.999999881e-01f}, {8.666666746e-01f, 1.333333254e-01f}, {9.333333373e-01f, 6.666666269e-02f},
+    {0.000000000e+00f, 1.000000000e+00f}, {5.882352963e-02f, 9.411764741e-01f}, {1.176470593e-01f, 8.823529482e-01f},
+    {1.764705926e-01f, 8.235294223e-01f}, {2.352941185e-01f, 7.647058964e-01f}, {2.941176593e-01f, 7.058823109e-01f},
+    {3.529411852e-01f, 6.470588446e-01f}, {4.117647111e-01f, 5.882352591e-01f}, {4.705882370e-01f, 5.294117928e-01f},
+    {5.294117928e-01f, 4.705882072e-01f}, {5.882353187e-01f, 4.117646813e-01f}, {6.470588446e-01f, 3.529411554e-01f},
+    {7.058823705e-01f, 2.941176295e-01f}, {7.647058964e-01f, 2.352941036e-01f}, {8.235294223e-01f, 1.764705777e-01f},
+    {8.823529482e-01f, 1.176470518e-01f}, {9.411764741e-01f, 5.882352591e-02f},
+};
+#endif /* APP_FRONTEND_FUSED */
+
+#if defined(APP_FRONTEND_Q15)
+// Ventana de Hann (_K11) en Q31
+static const int32_t hann512_q31[512] = {
+    0, 81168, 324658, 730434, 1298435, 2028575,
+    2920743, 3974804, 5190600, 6567946, 8106634, 9806432,
+    11667082, 13688303, 15869790, 18211212, 20712216, 23372424,
+    26191434, 29168818, 32304128, 35596888, 39046604, 42652748,
+    46414780, 50332132, 54404208, 58630392, 63010052, 67542520,
+    72227104, 77063112, 82049800, 87186416, 92472192, 97906320,
+    103487976, 109216328, 115090496, 121109608, 127272736, 133578960,
+    140027328, 146616864, 153346560, 160215408, 167222368, 174366384,
+    181646368, 189061232, 196609840, 204291072, 212103744, 220046688,
+    228118688, 236318544, 244645008, 253096816, 261672688, 270371360,
+    279191456, 288131680, 297190720, 306367104, 315659552, 325066592,
+    334586816, 344218816, 353961088, 363812192, 373770592, 383834848,
+    394003424, 404274752, 414647296, 425119488, 435689728, 446356448,
+    457118016, 467972800, 478919168, 489955488, 501080032, 512291168,
+    523587200, 534966400, 546427072, 557967424, 569585792, 581280384,
+    593049408, 604891136, 616803712, 628785408, 640834368, 652948736,
+    665126784, 677366528, 689666240, 702024064, 714438016, 726906368,
+    739427072, 751998336, 764618304, 777284928, 789996416, 802750848,
+    815546176, 828380544, 841252032, 854158656, 867098496, 880069568,
+    893069952, 906097600, 919150592, 932227008, 945324800, 958441984,
+    971576640, 984726656, 997890240, 1011065216, 1024249664, 1037441664,
+    1050639104, 1063840000, 1077042432, 1090244352, 1103443840, 1116638848,
+    1129827200, 1143007232, 1156176768, 1169333760, 1182476416, 1195602560,
+    1208710272, 1221797632, 1234862592, 1247903232, 1260917376, 1273903360,
+    1286859136, 1299782528, 1312671872, 1325524992, 1338340096, 1351115264,
+    1363848448, 1376537728, 1389181312, 1401777152, 1414323328, 1426818176,
+    1439259520, 1451645696, 1463974656, 1476244608, 1488453760, 1500600192,
+    1512682112, 1524697600, 1536644992, 1548522368, 1560327936, 1572059904,
+    1583716608, 1595296256, 1606796928, 1618217088, 1629554944, 1640808704,
+    1651976832, 1663057408, 1674049024, 1684949760, 1695758208, 1706472576,
+    1717091200, 1727612672, 1738035200, 1748357376, 1758577408, 1768694016,
+    1778705536, 1788610560, 1798407424, 1808094720, 1817671040, 1827134848,
+    1836484736, 1845719296, 1854837248, 1863837056, 1872717312, 1881476864,
+    1890114304, 1898628352, 1907017600, 1915280896, 1923416960, 1931424640,
+    1939302656, 1947049728, 1954664704, 1962146688, 1969494144, 1976706304,
+    1983782016, 1990720000, 1997519360, 2004179200, 2010698240, 2017075584,
+    2023310464, 2029401600, 2035348352, 2041149824, 2046804864, 2052312832,
+    2057672960, 2062884224, 2067945984, 2072857472, 2077617792, 2082226432,
+    2086682624, 2090985600, 2095134720, 2099129600, 2102969344, 2106653440,
+    2110181504, 2113552768, 2116766848, 2119823232, 2122721536, 2125461248,
+    2128041856, 2130463104, 2132724608, 2134825984, 2136766976, 2138547200,
+    2140166528, 2141624576, 2142921088, 2144056064, 2145029248, 2145840384,
+    2146489472, 2146976384, 2147300992, 2147463296, 2147463296, 2147300992,
+    2146976384, 2146489472, 2145840384, 2145029248, 2144056064, 2142921088,
+    2141624576, 2140166528, 2138547200, 2136766976, 2134825984, 2132724608,
+    2130463104, 2128041856, 2125461248, 2122721536, 2119823232, 2116766848,
+    2113552768, 2110181504, 2106653440, 2102969344, 2099129600, 2095134720,
+    2090985600, 2086682624, 2082226432, 2077617792, 2072857472, 2067945984,
+    2062884224, 2057672960, 2052312832, 2046804864, 2041149824, 2035348352,
+    2029401600, 2023310464, 2017075584, 2010698240, 2004179200, 1997519360,
+    1990720000, 1983782016, 1976706304, 1969494144, 1962146688, 1954664704,
+    1947049728, 1939302656, 1931424640, 1923416960, 1915280896, 1907017600,
+    1898628352, 1890114304, 1881476864, 1872717312, 1863837056, 1854837248,
+    1845719296, 1836484736, 1827134848, 1817671040, 1808094720, 1798407424,
+    1788610560, 1778705536, 1768694016, 1758577408, 1748357376, 1738035200,
+    1727612672, 1717091200, 1706472576, 1695758208, 1684949760, 1674049024,
+    1663057408, 1651976832, 1640808704, 1629554944, 1618217088, 1606796928,
+    1595296256, 1583716608, 1572059904, 1560327936, 1548522368, 1536644992,
+    1524697600, 1512682112, 1500600192, 1488453760, 1476244608, 1463974656,
+    1451645696, 1439259520, 1426818176, 1414323328, 1401777152, 1389181312,
+    1376537728, 1363848448, 1351115264, 1338340096, 1325524992, 1312671872,
+    1299782528, 1286859136, 1273903360, 1260917376, 1247903232, 1234862592,
+    1221797632, 1208710272, 1195602560, 1182476416, 1169333760, 1156176768,
+    1143007232, 1129827200, 1116638848, 1103443840, 1090244352, 1077042432,
+    1063840000, 1050639104, 1037441664, 1024249664, 1011065216, 997890240,
+    984726656, 971576640, 958441984, 945324800, 932227008, 919150592,
+    906097600, 893069952, 880069568, 867098496, 854158656, 841252032,
+    828380544, 815546176, 802750848, 789996416, 777284928, 764618304,
+    751998336, 739427072, 726906368, 714438016, 702024064, 689666240,
+    677366528, 665126784, 652948736, 640834368, 628785408, 616803712,
+    604891136, 593049408, 581280384, 569585792, 557967424, 546427072,
+    534966400, 523587200, 512291168, 501080032, 489955488, 478919168,
+    467972800, 457118016, 446356448, 435689728, 425119488, 414647296,
+    404274752, 394003424, 383834848, 373770592, 363812192, 353961088,
+    344218816, 334586816, 325066592, 315659552, 306367104, 297190720,
+    288131680, 279191456, 270371360, 261672688, 253096816, 244645008,
+    236318544, 228118688, 220046688, 212103744, 204291072, 196609840,
+    189061232, 181646368, 174366384, 167222368, 160215408, 153346560,
+    146616864, 140027328, 133578960, 127272736, 121109608, 115090496,
+    109216328, 103487976, 97906320, 92472192, 87186416, 82049800,
+    77063112, 72227104, 67542520, 63010052, 58630392, 54404208,
+    50332132, 46414780, 42652748, 39046604, 35596888, 32304128,
+    29168818, 26191434, 23372424, 20712216, 18211212, 15869790,
+    13688303, 11667082, 9806432, 8106634, 6567946, 5190600,
+    3974804, 2920743, 2028575, 1298435, 730434, 324658,
+    81168, 0,
+};
+
+// Pesos mel en Q15 sin signo: 1.0 = 32768
+typedef struct {
+    uint16_t rise;
+    uint16_t fall;
+} mel_weight_q15_t;
+
+static const mel_weight_q15_t mel_weight_q15[MEL_TABLE_BINS] = {
+    {0, 32768}, {16384, 16384}, {0, 32768}, {16384, 16384}, {0, 32768}, {10923, 21845},
+    {21845, 10923}, {0, 32768}, {16384, 16384}, {0, 32768}, {10923, 21845}, {21845, 10923},
+    {0, 32768}, {10923, 21845}, {21845, 10923}, {0, 32768}, {10923, 21845}, {21845, 10923},
+    {0, 32768}, {10923, 21845}, {21845, 10923}, {0, 32768}, {8192, 24576}, {16384, 16384},
+    {24576, 8192}, {0, 32768}, {8192, 24576}, {16384, 16384}, {24576, 8192}, {0, 32768},
+    {8192, 24576}, {16384, 16384}, {24576, 8192}, {0, 32768}, {8192, 24576}, {16384, 16384},
+    {24576, 8192}, {0, 32768}, {6554, 26214}, {13107, 19661}, {19661, 13107}, {26214, 6554},
+    {0, 32768}, {6554, 26214}, {13107, 19661}, {19661, 13107}, {26214, 6554}, {0, 32768},
+    {5461, 27307}, {10923, 21845}, {16384, 16384}, {21845, 10923}, {27307, 5461}, {0, 32768},
+    {6554, 26214}, {13107, 19661}, {19661, 13107}, {26214, 6554}, {0, 32768}, {4681, 28087},
+    {9362, 23406}, {14043, 18725}, {18725, 14043}, {23406, 9362}, {28087, 4681}, {0, 32768},
+    {5461, 27307}, {10923, 21845}, {16384, 16384}, {21845, 10923}, {27307, 5461}, {0, 32768},
+    {4096, 28672}, {8192, 24576}, {12288, 20480}, {16384, 16384}, {20480, 12288}, {24576, 8192},
+    {28672, 4096}, {0, 32768}, {4681, 28087}, {9362, 23406}, {14043, 18725}, {18725, 14043},
+    {23406, 9362}, {28087, 4681}, {0, 32768}, {3641, 29127}, {7282, 25486}, {10923, 21845},
+    {14564, 18204}, {18204, 14564}, {21845, 10923}, {25486, 7282}, {29127, 3641}, {0, 32768},
+    {4096, 28672}, {8192, 24576}, {12288, 20480}, {16384, 16384}, {20480, 12288}, {24576, 8192},
+    {28672, 4096}, {0, 32768}, {3277, 29491}, {6554, 26214}, {9830, 22938}, {13107, 19661},
+    {16384, 16384}, {19661, 13107}, {22938, 9830}, {26214, 6554}, {29491, 3277}, {0, 32768},
+    {3277, 29491}, {6554, 26214}, {9830, 22938}, {13107, 19661}, {16384, 16384}, {19661, 13107},
+    {22938, 9830}, {26214, 6554}, {29491, 3277}, {0, 32768}, {2979, 29789}, {5958, 26810},
+    {8937, 23831}, {11916, 20852}, {14895, 17873}, {17873, 14895}, {20852, 11916}, {23831, 8937},
+    {26810, 5958}, {29789, 2979}, {0, 32768}, {2731, 30037}, {5461, 27307}, {8192, 24576},
+    {10923, 21845}, {13653, 19115}, {16384, 16384}, {19115, 13653}, {21845, 10923}, {24576, 8192},
+    {27307, 5461}, {30037, 2731}, {0, 32768}, {2731, 30037}, {5461, 27307}, {8192, 24576},
+    {10923, 21845}, {13653, 19115}, {16384, 16384}, {19115, 13653}, {21845, 10923}, {24576, 8192},
+    {27307, 5461}, {30037, 2731}, {0, 32768}, {2341, 30427}, {4681, 28087}, {7022, 25746},
+    {9362, 23406}, {11703, 21065}, {14043, 18725}, {16384, 16384}, {18725, 14043}, {21065, 11703},
+    {23406, 9362}, {25746, 7022}, {28087, 4681}, {30427, 2341}, {0, 32768}, {2341, 30427},
+    {4681, 28087}, {7022, 25746}, {9362, 23406}, {11703, 21065}, {14043, 18725}, {16384, 16384},
+    {18725, 14043}, {21065, 11703}, {23406, 9362}, {25746, 7022}, {28087, 4681}, {30427, 2341},
+    {0, 32768}, {2185, 30583}, {4369, 28399}, {6554, 26214}, {8738, 24030}, {10923, 21845},
+    {13107, 19661}, {15292, 17476}, {17476, 15292}, {19661, 13107}, {21845, 10923}, {24030, 8738},
+    {26214, 6554}, {28399, 4369}, {30583, 2185}, {0, 32768}, {1928, 30840}, {3855, 28913},
+    {5783, 26985}, {7710, 25058}, {9638, 23130}, {11565, 21203}, {13493, 19275}, {15420, 17348},
+    {17348, 15420}, {19275, 13493}, {21203, 11565}, {23130, 9638}, {25058, 7710}, {26985, 5783},
+    {28913, 3855}, {30840, 1928},
+};
+
+// ln(1 + i / 128) en Q24, una entrada más para interpolar la última
+#define LN_TABLE_BITS 7
+static const int32_t ln_table_q24[(1 << LN_TABLE_BITS) + 1] = {
+    0, 130563, 260117, 388679, 516263, 642884, 768556, 893295,
+    1017112, 1140023, 1262040, 1383175, 1503443, 1622854, 1741421, 1859157,
+    1976071, 2092177, 2207485, 2322006, 2435750, 2548728, 2660951, 2772428,
+    2883169, 2993184, 3102482, 3211073, 3318965, 3426168, 3532691, 3638541,
+    3743728, 3848259, 3952143, 4055388, 4158001, 4259990, 4361364, 4462128,
+    4562291, 4661859, 4760840, 4859240, 4957067, 5054326, 5151025, 5247170,
+    5342767, 5437822, 5532342, 5626332, 5719799, 5812748, 5905184, 5997115,
+    6088544, 6179477, 6269921, 6359879, 6449358, 6538362, 6626896, 6714966,
+    6802576, 6889730, 6976434, 7062693, 7148510, 7233890, 7318838, 7403359,
+    7487455, 7571132, 7654394, 7737245, 7819688, 7901728, 7983370, 8064615,
+    8145469, 8225936, 8306018, 8385720, 8465045, 8543997, 8622579, 8700794,
+    8778647, 8856140, 8933277, 9010061, 9086495, 9162582, 9238326, 9313729,
+    9388795, 9463527, 9537927, 9611998, 9685745, 9759168, 9832271, 9905058,
+    9977530, 10049690, 10121541, 10193086, 10264327, 10335266, 10405907, 10476252,
+    10546303, 10616063, 10685534, 10754719, 10823619, 10892237, 10960577, 11028638,
+    11096425, 11163939, 11231183, 11298158, 11364866, 11431311, 11497493, 11563416,
+    11629080,
+};
+#endif /* APP_FRONTEND_Q15 */
+
+#endif /* MODEL1AUDIO_TABLES_H_ */
@@ -0,0 +1,96 @@
+#include "cyhal.h"
+#include <FreeRTOS.h>
+#include <task.h>
+#include <queue.h>
+#include <stdio.h>
+#include "queue_monitor.h"
+#include "cycle_counter.h"
+#include "trace_recorder.h"
+#include "report.h"
+#include "config.h"
+
+static monitored_queue_t queues[QUEUE_MONITOR_MAX_QUEUES];
+static int queue_count = 0;
+
+monitored_queue_t *queue_monitor_register(QueueHandle_t handle, const char *name, uint32_t length)
+{
+    if (handle == NULL || queue_count >= QUEUE_MONITOR_MAX_QUEUES)
+    {
+        printf("QUEUE: no se pudo registrar '%s'\n", name);
+        return NULL;
+    }
+
+    monitored_queue_t *queue = &queues[queue_count++];
+    queue->handle = handle;
+    queue->name = name;
+    queue->length = length;
+    histogram_reset(&queue->depth);
+    histogram_reset(&queue->wait_us);
+    TRACE_NAME_QUEUE(handle, name);
+    return queue;
+}
+
+BaseType_t queue_monitor_send(monitored_queue_t *queue, message_t *msg, TickType_t timeout)
+{
+    msg->enqueue_cycles = cycle_counter_now();
+
+    BaseType_t result = xQueueSend(queue->handle, msg, timeout);
+    UBaseType_t depth = uxQueueMessagesWaiting(queue->handle);
+
+    // Varios clientes e IA envían a la misma cola
+    taskENTER_CRITICAL();
+    if (result == pdTRUE)
+    {
+        queue->sent++;
+        histogram_record(&queue->depth, depth);
+        if (depth > queue->peak_depth)
+        {
+            queue->peak_depth = depth;
+        }
+    }
+    else
+    {
+        queue->full_events++;
+    }
+    taskEXIT_CRITICAL();
+
+    return result;
+}
+
+BaseType_t queue_monitor_receive(monitored_queue_t *queue, message_t *msg, TickType_t timeout)
+{
+    BaseType_t result = xQueueReceive(queue->handle, msg, timeout);
+
+    if (result == pdTRUE)
+    {
+        uint32_t wait_us = cycles_to_us(cycle_counter_now() - msg->enqueue_cycles);
+
+        taskENTER_CRITICAL();
+        queue->received++;
+        histogram_record(&queue->wait_us, wait_us);
+        taskEXIT_CRITICAL();
+    }
+
+    return result;
+}
+
+int queue_monitor_report(char *buffer, size_t buffer_size)
+{
+    int len = report_append(buffer, buffer_size, 0,
+                            "=== COLAS ===\n"
+                            "COLA            LONG  PICO  LLENA  ENVIADOS  RECIBIDOS\n");
+
+    for (int i = 0; i < queue_count; i++)
+    {
+        const monitored_queue_t *queue = &queues[i];
+
+        len = report_append(buffer, buffer_size, len, "%-15s %4lu  %4lu  %5lu  %8lu  %9lu\n",
+                            queue->name, (unsigned long)queue->length, (unsigned long)queue->peak_depth,
+                            (unsigned long)queue->full_events, (unsigned long)queue->sent,
+                            (unsigned long)queue->received);
+        len = histogram_report(&queue->depth, "  ocupacion", "msg", buffer, buffer_size, len);
+        len = histogram_report(&queue->wait_us, "  espera", "us", buffer, buffer_size, len);
+    }
+
+    return len;
+}
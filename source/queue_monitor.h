@@ -0,0 +1,41 @@
+#ifndef QUEUE_MONITOR_H_
+#define QUEUE_MONITOR_H_
+
+#include <FreeRTOS.h>
+#include <queue.h>
+#include "types.h"
+#include "histogram.h"
+
+// Envoltorio de las colas de message_t entre tareas. Cada envío marca el
+// mensaje con el contador de ciclos; cada recepción registra el tiempo que
+// pasó en la cola. También registra la ocupación vista al encolar, el pico y
+// los envíos fallidos por cola llena.
+struct monitored_queue
+{
+    QueueHandle_t handle;
+    const char *name;
+    uint32_t length;
+    uint32_t peak_depth;
+    uint32_t full_events; // Envíos que agotaron el timeout con la cola llena
+    uint32_t sent;
+    uint32_t received;
+    histogram_t depth;   // Mensajes en cola tras cada envío
+    histogram_t wait_us; // Tiempo en cola por mensaje
+};
+
+// Registra una cola ya creada; también la nombra para el registrador de trazas.
+// Devuelve NULL si la tabla (QUEUE_MONITOR_MAX_QUEUES) está llena.
+monitored_queue_t *queue_monitor_register(QueueHandle_t handle, const char *name, uint32_t length);
+
+BaseType_t queue_monitor_send(monitored_queue_t *queue, message_t *msg, TickType_t timeout);
+BaseType_t queue_monitor_receive(monitored_queue_t *queue, message_t *msg, TickType_t timeout);
+
+static inline UBaseType_t queue_monitor_waiting(const monitored_queue_t *queue)
+{
+    return uxQueueMessagesWaiting(queue->handle);
+}
+
+// Tabla por cola y histogramas de ocupación y espera
+int queue_monitor_report(char *buffer, size_t buffer_size);
+
+#endif /* QUEUE_MONITOR_H_ */
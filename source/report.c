@@ -0,0 +1,28 @@
+#include <stdarg.h>
+#include <stdio.h>
+#include "report.h"
+
+int report_append(char *buffer, size_t buffer_size, int len, const char *fmt, ...)
+{
+    if (buffer_size == 0 || len < 0 || (size_t)len >= buffer_size - 1)
+    {
+        return len;
+    }
+
+    va_list args;
+    va_start(args, fmt);
+    int written = vsnprintf(buffer + len, buffer_size - len, fmt, args);
+    va_end(args);
+
+    if (written < 0)
+    {
+        return len;
+    }
+
+    len += written;
+    if ((size_t)len >= buffer_size)
+    {
+        len = buffer_size - 1; // Truncado
+    }
+    return len;
+}
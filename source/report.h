@@ -0,0 +1,11 @@
+#ifndef REPORT_H_
+#define REPORT_H_
+
+#include <stddef.h>
+
+// Agrega texto con formato a un buffer de reporte. Devuelve la nueva longitud,
+// truncada a buffer_size - 1 si no cabe (el buffer siempre queda terminado en '\0').
+int report_append(char *buffer, size_t buffer_size, int len, const char *fmt, ...)
+    __attribute__((format(printf, 4, 5)));
+
+#endif /* REPORT_H_ */
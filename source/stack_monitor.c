@@ -0,0 +1,178 @@
+#include "cyhal.h"
+#include "cyabs_rtos.h"
+#include <FreeRTOS.h>
+#include <task.h>
+#include <semphr.h>
+#include <string.h>
+#include <stdio.h>
+#include "stack_monitor.h"
+#include "report.h"
+#include "config.h"
+
+#define STACK_MONITOR_MAX_ENTRIES 12
+#define STACK_MONITOR_MAX_TASKS 24 // Incluye tareas de lwIP, WHD, WCM, IDLE y timers
+#define STACK_ROUND_WORDS 64       // Recomendaciones redondeadas a 256 bytes
+
+typedef struct
+{
+    const char *prefix;
+    size_t prefix_len;
+    uint32_t stack_words;    // Tamaño configurado en xTaskCreate
+    uint32_t min_free_words; // Mínimo histórico libre (UINT32_MAX = sin muestras)
+    TaskHandle_t handle;     // Solo tareas de larga vida
+} stack_entry_t;
+
+static stack_entry_t entries[STACK_MONITOR_MAX_ENTRIES];
+static int entry_count = 0;
+static TaskStatus_t task_status[STACK_MONITOR_MAX_TASKS];
+static SemaphoreHandle_t report_mutex;
+#if defined(APP_ZERO_HEAP)
+static StaticSemaphore_t report_mutex_struct;
+#endif
+
+static stack_entry_t *find_entry(const char *task_name)
+{
+    for (int i = 0; i < entry_count; i++)
+    {
+        if (strncmp(task_name, entries[i].prefix, entries[i].prefix_len) == 0)
+        {
+            return &entries[i];
+        }
+    }
+    return NULL;
+}
+
+static void update_min_free(stack_entry_t *entry, uint32_t free_words)
+{
+    taskENTER_CRITICAL();
+    if (free_words < entry->min_free_words)
+    {
+        entry->min_free_words = free_words;
+    }
+    taskEXIT_CRITICAL();
+}
+
+static uint32_t recommended_words(const stack_entry_t *entry)
+{
+    uint32_t peak = entry->stack_words - entry->min_free_words;
+    uint32_t words = peak + (peak * STACK_MONITOR_MARGIN_PCT) / 100;
+
+    words = (words + STACK_ROUND_WORDS - 1) & ~(uint32_t)(STACK_ROUND_WORDS - 1);
+    if (words < configMINIMAL_STACK_SIZE)
+    {
+        words = configMINIMAL_STACK_SIZE;
+    }
+    return words;
+}
+
+void stack_monitor_register(const char *name_prefix, uint32_t stack_words, TaskHandle_t handle)
+{
+    if (report_mutex == NULL)
+    {
+#if defined(APP_ZERO_HEAP)
+        report_mutex = xSemaphoreCreateMutexStatic(&report_mutex_struct);
+#else
+        report_mutex = xSemaphoreCreateMutex();
+#endif
+    }
+
+    if (entry_count >= STACK_MONITOR_MAX_ENTRIES)
+    {
+        printf("STACK: tabla de monitoreo llena, '%s' no registrada\n", name_prefix);
+        return;
+    }
+
+    stack_entry_t *entry = &entries[entry_count];
+    entry->prefix = name_prefix;
+    entry->prefix_len = strlen(name_prefix);
+    entry->stack_words = stack_words;
+    entry->min_free_words = UINT32_MAX;
+    entry->handle = handle;
+    entry_count++;
+}
+
+void stack_monitor_sample(void)
+{
+    for (int i = 0; i < entry_count; i++)
+    {
+        if (entries[i].handle != NULL)
+        {
+            update_min_free(&entries[i], uxTaskGetStackHighWaterMark(entries[i].handle));
+        }
+    }
+}
+
+void stack_monitor_sample_self(void)
+{
+    stack_entry_t *entry = find_entry(pcTaskGetName(NULL));
+
+    if (entry != NULL)
+    {
+        update_min_free(entry, uxTaskGetStackHighWaterMark(NULL));
+    }
+}
+
+int stack_monitor_report(char *buffer, size_t buffer_size)
+{
+    int len = 0;
+
+    if (report_mutex == NULL || xSemaphoreTake(report_mutex, pdMS_TO_TICKS(100)) != pdTRUE)
+    {
+        return report_append(buffer, buffer_size, 0, "STACKS: monitor ocupado\n");
+    }
+
+    // Recorre todas las tareas vivas: sirve también como muestra de las efímeras
+    UBaseType_t task_count = uxTaskGetSystemState(task_status, STACK_MONITOR_MAX_TASKS, NULL);
+
+    for (UBaseType_t t = 0; t < task_count; t++)
+    {
+        stack_entry_t *entry = find_entry(task_status[t].pcTaskName);
+        if (entry != NULL)
+        {
+            update_min_free(entry, task_status[t].usStackHighWaterMark);
+        }
+    }
+
+    len = report_append(buffer, buffer_size, len,
+                        "=== PILAS (bytes) ===\n"
+                        "TAREA            CONFIG    PICO   RECOM\n");
+
+    for (int i = 0; i < entry_count; i++)
+    {
+        const stack_entry_t *entry = &entries[i];
+
+        if (entry->min_free_words == UINT32_MAX)
+        {
+            len = report_append(buffer, buffer_size, len, "%-15s %7lu  sin muestras\n",
+                                entry->prefix, entry->stack_words * sizeof(StackType_t));
+            continue;
+        }
+
+        len = report_append(buffer, buffer_size, len, "%-15s %7lu %7lu %7lu\n",
+                            entry->prefix,
+                            entry->stack_words * sizeof(StackType_t),
+                            (entry->stack_words - entry->min_free_words) * sizeof(StackType_t),
+                            recommended_words(entry) * sizeof(StackType_t));
+    }
+
+    // Tareas del sistema: solo se conoce la pila libre mínima
+    for (UBaseType_t t = 0; t < task_count; t++)
+    {
+        if (find_entry(task_status[t].pcTaskName) == NULL)
+        {
+            len = report_append(buffer, buffer_size, len, "%-15s   libre min %lu\n",
+                                task_status[t].pcTaskName,
+                                (uint32_t)task_status[t].usStackHighWaterMark * sizeof(StackType_t));
+        }
+    }
+
+    if (task_count == 0)
+    {
+        len = report_append(buffer, buffer_size, len,
+                            "ADVERTENCIA: mas de %d tareas, aumentar STACK_MONITOR_MAX_TASKS\n",
+                            STACK_MONITOR_MAX_TASKS);
+    }
+
+    xSemaphoreGive(report_mutex);
+    return len;
+}
@@ -0,0 +1,23 @@
+#ifndef STACK_MONITOR_H_
+#define STACK_MONITOR_H_
+
+#include <FreeRTOS.h>
+#include <task.h>
+#include <stddef.h>
+
+// Registra una clase de tareas por prefijo de nombre ("Cliente_" cubre a todos
+// los clientes). stack_words es el tamaño pasado a xTaskCreate (palabras).
+// Si handle != NULL la tarea es de larga vida y se muestrea desde
+// stack_monitor_sample(); las tareas efímeras se muestrean a sí mismas.
+void stack_monitor_register(const char *name_prefix, uint32_t stack_words, TaskHandle_t handle);
+
+// Actualiza el mínimo histórico de pila libre de las tareas registradas con handle
+void stack_monitor_sample(void);
+
+// Actualiza el mínimo histórico de la tarea que llama
+void stack_monitor_sample_self(void);
+
+// Tabla de uso y tamaño recomendado por tarea. Devuelve los bytes escritos.
+int stack_monitor_report(char *buffer, size_t buffer_size);
+
+#endif /* STACK_MONITOR_H_ */
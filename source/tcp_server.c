@@ -2,14 +2,25 @@
 #include "cybsp.h"
 #include "cy_retarget_io.h"
 #include "cyabs_rtos.h"
-#include "cy_secure_sockets.h"
 #include "cy_wcm.h"
 #include "cy_nw_helper.h"
 #include <string.h>
+#include <stdatomic.h>
 #include <queue.h>
 #include "tcp_server.h"
 #include "config.h"
 #include "types.h"
+#include "stack_monitor.h"
+#include "heap_monitor.h"
+#include "report.h"
+#include "trace_recorder.h"
+#include "queue_monitor.h"
+#include "latency_monitor.h"
+#include "histogram.h"
+#include "cycle_counter.h"
+#include "transport.h"
+#include "command.h"
+#include "ia.h"
 
 // TIPOS Y ENUMERACIONES
 typedef enum
@@ -29,17 +40,59 @@ typedef enum
     ERROR_RESOURCE
 } error_type_t;
 
+// Tráfico y comportamiento de una conexión
 typedef struct
 {
-    cy_socket_t socket;
-    client_state_t state;
+    uint32_t connected_at_ms;
+    uint32_t bytes_in;
+    uint32_t bytes_out;
+    uint32_t commands;     // Todos los recibidos, locales incluidos
+    uint32_t responses;    // Respuestas de control enviadas
+    uint32_t drops;        // Buffer de respuestas lleno, cola de control llena o broadcasts perdidos
+    uint32_t send_errors;
+    uint32_t rtt_count;    // RTT = recv del comando -> respuesta enviada
+    uint32_t rtt_max_us;
+    uint64_t rtt_total_us;
+} client_stats_t;
+
+// Palabra de estado de una ranura: estado en los 8 bits bajos y generación
+// (cada conexión aceptada la incrementa) en los 24 altos. Solo cambia por CAS.
+#define SLOT_STATE(word) ((client_state_t)((word) & 0xFFu))
+#define SLOT_GENERATION(word) ((word) >> 8)
+#define SLOT_WORD(generation, state) (((generation) << 8) | (uint32_t)(state))
+
+typedef struct
+{
+    transport_conn_t *conn;
+    _Atomic uint32_t slot; // SLOT_WORD(generación, client_state_t)
     TaskHandle_t task_handle;
     uint32_t client_id;
     uint32_t last_activity;
-    cy_socket_sockaddr_t peer_addr;
+    transport_addr_t peer_addr;
     task_params_t *params; // Agregar parÃ¡metros de colas
+    bool timing_echo;      // TIMING_ON: agrega la latencia por etapa a cada respuesta
+    uint32_t broadcast_next; // Próxima secuencia de broadcast a entregar
+    client_stats_t stats;  // La escribe la tarea dueña entre stats_begin/stats_end;
+                           // con rx_in_network, bytes_in y commands solo el transporte
+    _Atomic uint32_t stats_seq; // Seqlock de stats: impar mientras la dueña escribe
+    _Atomic uint32_t rx_drops;  // Descartes del hilo de red; se suman a stats.drops al reportar
+    bool rx_in_network;    // Comandos parseados en el contexto del transporte (set_rx_handler)
+    char rx_token[COMMAND_TOKEN_MAX + 1]; // Token en armado; más largo = desconocido
+    uint8_t rx_token_len;
+    bool rx_overflow;
+    _Atomic int8_t pending_local; // Comando local diferido a la tarea (-1 = ninguno)
+    atomic_bool pending_busy;     // Cola de control llena: avisar desde la tarea
+    atomic_bool rx_closed;        // El transporte avisó cierre o error
 } client_info_t;
 
+// Anillo de broadcasts (comandos por voz): cualquier tarea publica y cada
+// cliente entrega desde su propia tarea, sin tocar sockets ajenos
+typedef struct
+{
+    _Atomic uint32_t seq; // Secuencia publicada + 1 (0 = en escritura)
+    char text[64];
+} broadcast_entry_t;
+
 typedef struct
 {
     uint32_t recoverable_errors;
@@ -57,42 +110,237 @@ typedef struct
     volatile uint8_t count;
 } response_buffer_t;
 
+// Comandos de diagnóstico que responde el servidor sin pasar por control
+typedef int (*local_command_fn_t)(client_info_t *client, char *buffer, size_t buffer_size);
+
+typedef struct
+{
+    const char *cmd;
+    uint8_t cmd_len;
+    local_command_fn_t handler;
+} local_command_t;
+
+#if defined(APP_TRACE_RECORDER)
+#define DIAG_TRACE_HELP ", TRACE_ON/OFF, TRACE_DUMP"
+#else
+#define DIAG_TRACE_HELP ""
+#endif
+
+#if defined(APP_BENCH_SERVICES)
+#define DIAG_BENCH_HELP ", BENCH"
+#else
+#define DIAG_BENCH_HELP ""
+#endif
+
+// Índice de notificación con el que el manejador de recepción, control y los
+// broadcasts despiertan a la tarea del cliente (el 0 lo usan los workers del
+// modo sin heap)
+#define CLIENT_NOTIFY_RX 1
+#define CLIENT_IDLE_WAKE_MS 1000 // Sin avisos: timeout de inactividad y muestreo de pila
+
 // VARIABLES GLOBALES
 
-static cy_socket_t server_socket;
-static cy_socket_sockaddr_t server_addr;
+static const transport_ops_t *const transport = &TRANSPORT_BACKEND;
+static transport_conn_t *server_conn;
+static transport_addr_t server_addr;
 static client_info_t clients[MAX_CLIENTS];
-static SemaphoreHandle_t clients_mutex;
-static bool server_running = false;
-static uint32_t next_client_id = 1;
+static volatile bool server_running = false;
+static _Atomic uint32_t next_client_id = 1;
+static broadcast_entry_t broadcast_ring[BROADCAST_RING_SIZE];
+static _Atomic uint32_t broadcast_reserved = 0; // Próxima secuencia a publicar
+static volatile uint32_t foreign_responses = 0;   // Respuestas de otro cliente descartadas
 static error_stats_t error_stats = {0};
 static task_params_t *global_params; // Parámetros globales
 static response_buffer_t response_buffers[MAX_CLIENTS];
+#if defined(APP_ZERO_HEAP)
+// Modo sin heap: un worker estático por ranura, creado una sola vez
+static StackType_t client_stacks[MAX_CLIENTS][CLIENT_TASK_STACK_SIZE];
+static StaticTask_t client_tcbs[MAX_CLIENTS];
+#endif
+static char report_buffers[MAX_CLIENTS][REPORT_BUFFER_SIZE]; // Fuera de la pila del cliente
+
+// ESTADO DE RANURAS (sin bloqueo)
+static inline uint32_t slot_load(int client_index)
+{
+    return atomic_load_explicit(&clients[client_index].slot, memory_order_acquire);
+}
 
-// FUNCIONES DE MANEJO DE ERRORES (mantener las mismas)
-static void broadcast_to_clients(const char *message)
+// Cambia el estado conservando la generación; falla si otro lo cambió antes
+static bool slot_transition(int client_index, client_state_t from, client_state_t to)
 {
-    if (xSemaphoreTake(clients_mutex, pdMS_TO_TICKS(100)) == pdTRUE)
+    uint32_t word = slot_load(client_index);
+
+    while (SLOT_STATE(word) == from)
     {
-        for (int i = 0; i < MAX_CLIENTS; i++)
+        if (atomic_compare_exchange_weak_explicit(&clients[client_index].slot, &word,
+                                                  SLOT_WORD(SLOT_GENERATION(word), to),
+                                                  memory_order_acq_rel, memory_order_acquire))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+static inline client_state_t client_state(const client_info_t *client)
+{
+    return SLOT_STATE(atomic_load_explicit(&client->slot, memory_order_acquire));
+}
+
+// Seqlock de stats (un solo escritor: la tarea dueña). rtt_total_us es de
+// 64 bits y el M4 lo escribe en dos palabras.
+static inline void stats_begin(client_info_t *client)
+{
+    uint32_t seq = atomic_load_explicit(&client->stats_seq, memory_order_relaxed);
+    atomic_store_explicit(&client->stats_seq, seq + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+}
+
+static inline void stats_end(client_info_t *client)
+{
+    uint32_t seq = atomic_load_explicit(&client->stats_seq, memory_order_relaxed);
+    atomic_store_explicit(&client->stats_seq, seq + 1, memory_order_release);
+}
+
+// Copia de una ranura activa sin bloquear: false si no está activa, si
+// cambió de generación/estado durante la copia o si la dueña seguía a mitad
+// de actualizar stats tras CLIENT_SNAPSHOT_RETRIES intentos
+#define CLIENT_SNAPSHOT_RETRIES 3
+
+static bool client_snapshot(int client_index, client_info_t *out)
+{
+    client_info_t *client = &clients[client_index];
+    uint32_t before = slot_load(client_index);
+
+    if (SLOT_STATE(before) != CLIENT_STATE_ACTIVE)
+    {
+        return false;
+    }
+
+    for (int attempt = 0; attempt < CLIENT_SNAPSHOT_RETRIES; attempt++)
+    {
+        uint32_t seq = atomic_load_explicit(&client->stats_seq, memory_order_acquire);
+        if ((seq & 1u) == 0)
         {
-            if (clients[i].state == CLIENT_STATE_ACTIVE &&
-                clients[i].socket != CY_SOCKET_INVALID_HANDLE)
+            memcpy(out, client, sizeof(client_info_t));
+            atomic_thread_fence(memory_order_acquire);
+            if (atomic_load_explicit(&client->stats_seq, memory_order_relaxed) == seq)
             {
-                uint32_t bytes_sent;
-                char formatted_msg[128];
+                return slot_load(client_index) == before;
+            }
+        }
+        vTaskDelay(1); // Deja terminar a la dueña aunque tenga menor prioridad
+    }
+    return false;
+}
+
+// Envío completo desde la tarea dueña del cliente; contabiliza bytes y errores
+static cy_rslt_t client_send(client_info_t *client, const void *data, uint32_t len)
+{
+    uint32_t bytes_sent;
+    cy_rslt_t result = transport_send_all(transport, client->conn, data, len, &bytes_sent);
+
+    stats_begin(client);
+    client->stats.bytes_out += bytes_sent;
+    if (result != CY_RSLT_SUCCESS)
+    {
+        client->stats.send_errors++;
+    }
+    stats_end(client);
+    return result;
+}
+
+// Despierta a la tarea del cliente client_id (0 = a todas las activas). Con
+// el scheduler suspendido ninguna ranura se libera ni borra su tarea entre
+// la comprobación y el aviso.
+static void wake_clients(uint32_t client_id)
+{
+    vTaskSuspendAll();
+    for (int i = 0; i < MAX_CLIENTS; i++)
+    {
+        client_info_t *client = &clients[i];
+
+        if (SLOT_STATE(slot_load(i)) == CLIENT_STATE_ACTIVE && client->task_handle != NULL &&
+            (client_id == 0 || client->client_id == client_id))
+        {
+            xTaskNotifyGiveIndexed(client->task_handle, CLIENT_NOTIFY_RX);
+        }
+    }
+    xTaskResumeAll();
+}
 
-                // Formatear mensaje con prompt
-                snprintf(formatted_msg, sizeof(formatted_msg),
-                         "\n\x1b[31m[COMANDO POR VOZ] %s\x1b[0m\n> ", message);
+void tcp_server_notify_reply(uint32_t client_id)
+{
+    // Un broadcast lo publica la primera tarea que lo saque de la cola
+    wake_clients(client_id);
+}
+
+// BROADCASTS (comandos por voz)
+static void publish_broadcast(const char *message)
+{
+    uint32_t seq = atomic_fetch_add_explicit(&broadcast_reserved, 1, memory_order_relaxed);
+    broadcast_entry_t *entry = &broadcast_ring[seq % BROADCAST_RING_SIZE];
+
+    atomic_store_explicit(&entry->seq, 0, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    snprintf(entry->text, sizeof(entry->text), "%s", message);
+    atomic_store_explicit(&entry->seq, seq + 1, memory_order_release);
+
+    wake_clients(0);
+}
 
-                cy_socket_send(clients[i].socket, formatted_msg, strlen(formatted_msg),
-                               CY_SOCKET_FLAGS_NONE, &bytes_sent);
+// Entrega al cliente los broadcasts publicados desde su última visita
+static void deliver_broadcasts(client_info_t *client)
+{
+    uint32_t published = atomic_load_explicit(&broadcast_reserved, memory_order_acquire);
+
+    while (client->broadcast_next != published)
+    {
+        if (published - client->broadcast_next > BROADCAST_RING_SIZE)
+        {
+            // Se perdieron los más viejos
+            stats_begin(client);
+            client->stats.drops += published - client->broadcast_next - BROADCAST_RING_SIZE;
+            stats_end(client);
+            client->broadcast_next = published - BROADCAST_RING_SIZE;
+        }
+
+        broadcast_entry_t *entry = &broadcast_ring[client->broadcast_next % BROADCAST_RING_SIZE];
+        uint32_t expected = client->broadcast_next + 1;
+        uint32_t seq = atomic_load_explicit(&entry->seq, memory_order_acquire);
+        char formatted_msg[128];
+
+        if (seq != expected)
+        {
+            if (seq == 0 || (int32_t)(seq - expected) < 0)
+            {
+                return; // Aún en escritura: se reintenta en la próxima vuelta
             }
+            client->broadcast_next++; // Sobrescrito por uno más nuevo
+            stats_begin(client);
+            client->stats.drops++;
+            stats_end(client);
+            continue;
+        }
+
+        // Formatear mensaje con prompt
+        snprintf(formatted_msg, sizeof(formatted_msg),
+                 "\n\x1b[31m[COMANDO POR VOZ] %s\x1b[0m\n> ", entry->text);
+        atomic_thread_fence(memory_order_acquire);
+        client->broadcast_next++;
+
+        if (atomic_load_explicit(&entry->seq, memory_order_relaxed) != seq)
+        {
+            stats_begin(client);
+            client->stats.drops++; // Sobrescrito durante la copia
+            stats_end(client);
+            continue;
         }
-        xSemaphoreGive(clients_mutex);
+
+        client_send(client, formatted_msg, strlen(formatted_msg));
     }
 }
+// FUNCIONES DE MANEJO DE ERRORES (mantener las mismas)
 static error_type_t classify_error(cy_rslt_t error_code)
 {
     if (error_code == CY_RSLT_MODULE_SECURE_SOCKETS_TIMEOUT ||
@@ -130,7 +378,7 @@ static bool handle_error_enhanced(const char *context, cy_rslt_t error_code, boo
     case ERROR_RECOVERABLE:
         error_stats.recoverable_errors++;
         printf("ERROR RECUPERABLE en %s: 0x%08lX (Contador: %lu)\n",
-               context, error_code, error_stats.recoverable_errors);
+               context, (unsigned long)error_code, (unsigned long)error_stats.recoverable_errors);
         vTaskDelay(pdMS_TO_TICKS(100 * error_stats.recoverable_errors));
         return true;
 
@@ -138,7 +386,7 @@ static bool handle_error_enhanced(const char *context, cy_rslt_t error_code, boo
         printf("\x1b[31m");
         error_stats.network_errors++;
         printf("ERROR DE RED en %s: 0x%08lX (Contador: %lu)\n",
-               context, error_code, error_stats.network_errors);
+               context, (unsigned long)error_code, (unsigned long)error_stats.network_errors);
 
         if (is_critical_path && error_stats.network_errors < 5)
         {
@@ -149,7 +397,7 @@ static bool handle_error_enhanced(const char *context, cy_rslt_t error_code, boo
         return false;
 
     case ERROR_RESOURCE:
-        printf("ERROR DE RECURSOS en %s: 0x%08lX\n", context, error_code);
+        printf("ERROR DE RECURSOS en %s: 0x%08lX\n", context, (unsigned long)error_code);
 
         if (error_stats.recoverable_errors < 10)
         {
@@ -162,7 +410,7 @@ static bool handle_error_enhanced(const char *context, cy_rslt_t error_code, boo
     default:
         error_stats.critical_errors++;
         printf("ERROR CRÃTICO en %s: 0x%08lX (Contador: %lu)\n",
-               context, error_code, error_stats.critical_errors);
+               context, (unsigned long)error_code, (unsigned long)error_stats.critical_errors);
 
         if (is_critical_path && error_stats.critical_errors > 3)
         {
@@ -174,64 +422,54 @@ static bool handle_error_enhanced(const char *context, cy_rslt_t error_code, boo
 }
 
 // FUNCIONES DE GESTIÃ“N DE CLIENTES
+// Reclama una ranura libre (DISCONNECTED -> CONNECTED, nueva generación).
+// Quien la reclama es dueño de sus campos hasta publicarla.
 static int obtener_ranura_cliente_libre(void)
 {
-    if (xSemaphoreTake(clients_mutex, pdMS_TO_TICKS(100)) == pdTRUE)
+    for (int i = 0; i < MAX_CLIENTS; i++)
     {
-        for (int i = 0; i < MAX_CLIENTS; i++)
+        uint32_t word = slot_load(i);
+
+        if (SLOT_STATE(word) == CLIENT_STATE_DISCONNECTED &&
+            atomic_compare_exchange_strong_explicit(&clients[i].slot, &word,
+                                                    SLOT_WORD(SLOT_GENERATION(word) + 1, CLIENT_STATE_CONNECTED),
+                                                    memory_order_acq_rel, memory_order_acquire))
         {
-            if (clients[i].state == CLIENT_STATE_DISCONNECTED)
-            {
-                xSemaphoreGive(clients_mutex);
-                return i;
-            }
+            return i;
         }
-        xSemaphoreGive(clients_mutex);
     }
     return -1;
 }
 
+// Cierra el socket y libera la ranura. Solo la llama el dueño de la ranura
+// (su tarea de cliente, o accept si la tarea no llegó a crearse), así que
+// nadie más toca el socket ni borra la tarea.
 static void cleanup_client(int client_index)
 {
-    if (client_index < 0 || client_index >= MAX_CLIENTS)
-        return;
-
     client_info_t *client = &clients[client_index];
 
-    printf("Limpiando cliente %lu (ranura %d)\n", client->client_id, client_index);
-
-    if (client->socket != CY_SOCKET_INVALID_HANDLE)
-    {
-        cy_socket_disconnect(client->socket, 0);
-        cy_socket_delete(client->socket);
-        client->socket = CY_SOCKET_INVALID_HANDLE;
-    }
+    printf("Limpiando cliente %lu (ranura %d)\n", (unsigned long)client->client_id, client_index);
 
-    if (client->task_handle != NULL)
+    if (client->conn != NULL)
     {
-        vTaskDelete(client->task_handle);
-        client->task_handle = NULL;
+        transport->close(client->conn);
+        client->conn = NULL;
     }
 
-    memset(client, 0, sizeof(client_info_t));
-    client->state = CLIENT_STATE_DISCONNECTED;
-    client->socket = CY_SOCKET_INVALID_HANDLE;
-}
+#if !defined(APP_ZERO_HEAP)
+    // La tarea efímera se borra a sí misma después de liberar la ranura;
+    // en modo sin heap el worker de la ranura es permanente
+    client->task_handle = NULL;
+#endif
+    client->client_id = 0;
+    client->timing_echo = false;
+    client->rx_in_network = false;
+    memset(&response_buffers[client_index], 0, sizeof(response_buffer_t));
 
-static void cleanup_disconnected_clients(void)
-{
-    if (xSemaphoreTake(clients_mutex, pdMS_TO_TICKS(100)) == pdTRUE)
-    {
-        for (int i = 0; i < MAX_CLIENTS; i++)
-        {
-            if (clients[i].state == CLIENT_STATE_DISCONNECTED &&
-                clients[i].socket != CY_SOCKET_INVALID_HANDLE)
-            {
-                cleanup_client(i);
-            }
-        }
-        xSemaphoreGive(clients_mutex);
-    }
+    // Publicar la ranura libre al final: desde aquí puede reclamarla accept
+    uint32_t word = slot_load(client_index);
+    atomic_store_explicit(&client->slot, SLOT_WORD(SLOT_GENERATION(word), CLIENT_STATE_DISCONNECTED),
+                          memory_order_release);
 }
 
 // TAREA DE CLIENTE ACTUALIZADA
@@ -242,30 +480,41 @@ static bool process_control_responses(client_info_t *client, int client_index)
     bool has_responses = false;
 
     // Lear múltiples respuestas de una vez
-    while (xQueueReceive(client->params->queue_control_to_tcp, &response_msg, 0) == pdTRUE)
+    while (queue_monitor_receive(client->params->queue_control_to_tcp, &response_msg, 0) == pdTRUE)
     {
+        latency_monitor_stamp(&response_msg, LATENCY_REPLY_DEQUEUE);
+
         // Verificar si es un comando de voz (broadcast a todos)
         if (response_msg.value == 0) // Valor 0 indica broadcast
         {
-            printf("Broadcasting comando de voz: %s\n", response_msg.data);
-            broadcast_to_clients(response_msg.data);
+            char text[sizeof(broadcast_ring[0].text)];
+            command_format_response(&response_msg.cmd, response_msg.outputs, text, sizeof(text), 0);
+            printf("Broadcasting comando de voz: %s\n", text);
+            publish_broadcast(text);
             continue; // No almacenar en buffer individual
         }
 
+        // La cola es compartida: la respuesta de otro cliente se pierde
+        if (response_msg.value != client->client_id)
+        {
+            foreign_responses++;
+            continue;
+        }
+
         // Procesar respuestas normales para este cliente
-        if (response_msg.value == client->client_id || response_msg.value == 0)
+        if (rb->count < 8)
         {
-            if (rb->count < 8)
-            {
-                rb->messages[rb->head] = response_msg;
-                rb->head = (rb->head + 1) % 8;
-                rb->count++;
-                has_responses = true;
-            }
-            else
-            {
-                printf("TCP: Buffer de respuestas lleno para cliente %lu\n", client->client_id);
-            }
+            rb->messages[rb->head] = response_msg;
+            rb->head = (rb->head + 1) % 8;
+            rb->count++;
+            has_responses = true;
+        }
+        else
+        {
+            stats_begin(client);
+            client->stats.drops++;
+            stats_end(client);
+            printf("TCP: Buffer de respuestas lleno para cliente %lu\n", (unsigned long)client->client_id);
         }
     }
 
@@ -275,7 +524,6 @@ static void send_buffered_responses(client_info_t *client, int client_index)
 {
     response_buffer_t *rb = &response_buffers[client_index];
     char response_buffer[BUFFER_SIZE];
-    uint32_t bytes_sent;
     cy_rslt_t result;
 
     while (rb->count > 0)
@@ -283,14 +531,31 @@ static void send_buffered_responses(client_info_t *client, int client_index)
         message_t *msg = &rb->messages[rb->tail];
 
         // Formatear respuesta optimizada
-        int len = snprintf(response_buffer, sizeof(response_buffer),
-                           "%s\n> ", msg->data);
+        int len = command_format_response(&msg->cmd, msg->outputs, response_buffer, sizeof(response_buffer), 0);
+        if (client->timing_echo)
+        {
+            len = latency_monitor_format(msg, response_buffer, sizeof(response_buffer), len);
+        }
+        len = report_append(response_buffer, sizeof(response_buffer), len, "\n> ");
 
-        result = cy_socket_send(client->socket, response_buffer, len,
-                                CY_SOCKET_FLAGS_NONE, &bytes_sent);
+        result = client_send(client, response_buffer, len);
 
         if (result == CY_RSLT_SUCCESS)
         {
+            latency_monitor_stamp(msg, LATENCY_REPLY_SENT);
+            latency_monitor_record(msg);
+
+            uint32_t rtt_us = cycles_to_us(msg->stamps[LATENCY_REPLY_SENT] - msg->stamps[LATENCY_RECV]);
+            stats_begin(client);
+            client->stats.responses++;
+            client->stats.rtt_count++;
+            client->stats.rtt_total_us += rtt_us;
+            if (rtt_us > client->stats.rtt_max_us)
+            {
+                client->stats.rtt_max_us = rtt_us;
+            }
+            stats_end(client);
+
             // Remover del buffer circular
             rb->tail = (rb->tail + 1) % 8;
             rb->count--;
@@ -298,86 +563,618 @@ static void send_buffered_responses(client_info_t *client, int client_index)
         else
         {
             printf("TCP: Error enviando a cliente %lu: 0x%08lX\n",
-                   client->client_id, result);
+                   (unsigned long)client->client_id, (unsigned long)result);
             break; // Detener envÃ­o si hay error
         }
     }
 }
-static void process_client_command(client_info_t *client, char *buffer, size_t bytes_received)
+// Tabla por conexión activa a partir de copias sin bloqueo de cada ranura
+static int clients_report(char *buffer, size_t buffer_size, int len)
+{
+    uint32_t now_ms = xTaskGetTickCount() * portTICK_PERIOD_MS;
+    client_info_t snap;
+
+    len = report_append(buffer, buffer_size, len,
+                        "RAN   ID  IP               EDAD_S   CMDS   RESP    B_IN   B_OUT  DROP  ERR  RTT_MED  RTT_MAX\n");
+
+    for (int i = 0; i < MAX_CLIENTS; i++)
+    {
+        if (!client_snapshot(i, &snap))
+        {
+            continue;
+        }
+
+        const client_stats_t *st = &snap.stats;
+        uint32_t ip = snap.peer_addr.ipv4;
+        char ip_text[16];
+        snprintf(ip_text, sizeof(ip_text), "%lu.%lu.%lu.%lu",
+                 (unsigned long)((ip >> 0) & 0xFF), (unsigned long)((ip >> 8) & 0xFF),
+                 (unsigned long)((ip >> 16) & 0xFF), (unsigned long)((ip >> 24) & 0xFF));
+
+        len = report_append(buffer, buffer_size, len,
+                            "%3d %4lu  %-15s %7lu %6lu %6lu %7lu %7lu %5lu %4lu %8lu %8lu\n",
+                            i, (unsigned long)snap.client_id, ip_text,
+                            (unsigned long)((now_ms - st->connected_at_ms) / 1000),
+                            (unsigned long)st->commands, (unsigned long)st->responses,
+                            (unsigned long)st->bytes_in, (unsigned long)st->bytes_out,
+                            (unsigned long)(st->drops + snap.rx_drops), (unsigned long)st->send_errors,
+                            (unsigned long)(st->rtt_count ? (uint32_t)(st->rtt_total_us / st->rtt_count) : 0),
+                            (unsigned long)st->rtt_max_us);
+    }
+
+    return report_append(buffer, buffer_size, len, "Respuestas de otros clientes descartadas: %lu\n",
+                         (unsigned long)foreign_responses);
+}
+
+#if defined(APP_BENCH_SERVICES)
+// SERVICIOS DE PRUEBA DE RED (estilo iperf)
+// Un puerto y una tarea por servicio, una conexión a la vez. Miden el camino
+// Wi-Fi/lwIP/transporte sin pasar por el protocolo de control, con el mismo
+// backend que el servidor.
+
+#define PINGPONG_FRAME_SIZE 32
+
+typedef struct bench_service bench_service_t;
+typedef void (*bench_serve_fn_t)(bench_service_t *service, transport_conn_t *conn);
+
+struct bench_service
+{
+    const char *name;
+    uint16_t port;
+    bench_serve_fn_t serve;
+    uint32_t sessions;
+    uint64_t bytes_in;
+    uint64_t bytes_out;
+    uint32_t last_kbps;    // Sesión más reciente, bytes recibidos + enviados
+    histogram_t proc_us;   // Solo ping-pong: trama completa -> respuesta enviada
+    uint8_t buffer[BENCH_BUFFER_SIZE];
+};
+
+static void bench_serve_echo(bench_service_t *service, transport_conn_t *conn);
+static void bench_serve_discard(bench_service_t *service, transport_conn_t *conn);
+static void bench_serve_chargen(bench_service_t *service, transport_conn_t *conn);
+static void bench_serve_pingpong(bench_service_t *service, transport_conn_t *conn);
+
+static bench_service_t bench_services[] = {
+    {.name = "echo", .port = BENCH_ECHO_PORT, .serve = bench_serve_echo},
+    {.name = "discard", .port = BENCH_DISCARD_PORT, .serve = bench_serve_discard},
+    {.name = "chargen", .port = BENCH_CHARGEN_PORT, .serve = bench_serve_chargen},
+    {.name = "pingpong", .port = BENCH_PINGPONG_PORT, .serve = bench_serve_pingpong},
+};
+
+#define BENCH_SERVICE_COUNT (sizeof(bench_services) / sizeof(bench_service_t))
+
+#if defined(APP_ZERO_HEAP)
+static StackType_t bench_stacks[BENCH_SERVICE_COUNT][BENCH_TASK_STACK_SIZE];
+static StaticTask_t bench_tcbs[BENCH_SERVICE_COUNT];
+#endif
+
+// Envío completo; false si el otro extremo cerró o hubo error
+static bool bench_send(bench_service_t *service, transport_conn_t *conn, const uint8_t *data, uint32_t len)
+{
+    uint32_t bytes_sent;
+    cy_rslt_t result = transport_send_all(transport, conn, data, len, &bytes_sent);
+
+    service->bytes_out += bytes_sent;
+    return result == CY_RSLT_SUCCESS;
+}
+
+// Recepción con timeout de inactividad; 0 al cerrar, por error o por timeout
+static uint32_t bench_recv(bench_service_t *service, transport_conn_t *conn, uint8_t *data, uint32_t size)
 {
-    // Limpiar buffer de manera optimizada
-    buffer[bytes_received] = '\0';
+    uint32_t bytes_received = 0;
+    cy_rslt_t result = transport->recv(conn, data, size, &bytes_received);
 
-    // Remover caracteres de control de manera mÃ¡s eficiente
-    char *cmd_end = buffer + bytes_received - 1;
-    while (cmd_end >= buffer && (*cmd_end == '\n' || *cmd_end == '\r' || *cmd_end == ' '))
+    if (result != CY_RSLT_SUCCESS)
     {
-        *cmd_end-- = '\0';
+        return 0;
     }
+    service->bytes_in += bytes_received;
+    return bytes_received;
+}
 
-    // Skip leading whitespace
-    char *cmd_start = buffer;
-    while (*cmd_start == ' ' || *cmd_start == '\t')
-        cmd_start++;
+static void bench_serve_echo(bench_service_t *service, transport_conn_t *conn)
+{
+    uint32_t len;
 
-    if (strlen(cmd_start) == 0)
+    while ((len = bench_recv(service, conn, service->buffer, sizeof(service->buffer))) > 0)
+    {
+        if (!bench_send(service, conn, service->buffer, len))
+        {
+            break;
+        }
+    }
+}
+
+static void bench_serve_discard(bench_service_t *service, transport_conn_t *conn)
+{
+    while (bench_recv(service, conn, service->buffer, sizeof(service->buffer)) > 0)
+    {
+    }
+}
+
+// RFC 864: líneas de 72 caracteres imprimibles que rotan una posición
+static void bench_serve_chargen(bench_service_t *service, transport_conn_t *conn)
+{
+    uint32_t len = 0;
+
+    for (uint32_t line = 0; len + 74 <= sizeof(service->buffer); line++)
+    {
+        for (uint32_t k = 0; k < 72; k++)
+        {
+            service->buffer[len++] = (uint8_t)(' ' + (line + k) % 95);
+        }
+        service->buffer[len++] = '\r';
+        service->buffer[len++] = '\n';
+    }
+
+    while (bench_send(service, conn, service->buffer, len))
+    {
+    }
+}
+
+// Tramas de PINGPONG_FRAME_SIZE bytes, little-endian:
+//   0 seq (u32)  8 marca del cliente (u64, opaca)  se devuelven intactos
+//  16 tiempo en el servidor de la trama ANTERIOR, desde completa hasta enviada
+//     (u32, us; 0 en la primera): el de la actual solo se conoce tras el envío
+//  20 uptime de la placa (u32, ms)
+static void bench_serve_pingpong(bench_service_t *service, transport_conn_t *conn)
+{
+    uint8_t *frame = service->buffer;
+    uint32_t filled = 0;
+    uint32_t prev_proc_us = 0;
+
+    for (;;)
+    {
+        uint32_t len = bench_recv(service, conn, frame + filled, PINGPONG_FRAME_SIZE - filled);
+        if (len == 0)
+        {
+            break;
+        }
+        filled += len;
+        if (filled < PINGPONG_FRAME_SIZE)
+        {
+            continue;
+        }
+
+        uint32_t rx_cycles = cycle_counter_now(); // Trama completa
+        uint32_t uptime_ms = xTaskGetTickCount() * portTICK_PERIOD_MS;
+        memcpy(&frame[16], &prev_proc_us, sizeof(prev_proc_us));
+        memcpy(&frame[20], &uptime_ms, sizeof(uptime_ms));
+
+        if (!bench_send(service, conn, frame, PINGPONG_FRAME_SIZE))
+        {
+            break;
+        }
+        prev_proc_us = cycles_to_us(cycle_counter_now() - rx_cycles);
+        histogram_record(&service->proc_us, prev_proc_us);
+        filled = 0;
+    }
+}
+
+static void bench_task(void *param)
+{
+    bench_service_t *service = (bench_service_t *)param;
+    transport_addr_t addr = server_addr;
+    transport_conn_t *listener;
+
+    addr.port = service->port;
+    if (transport->listen(&addr, 1, false, &listener) != CY_RSLT_SUCCESS)
+    {
+        printf("BENCH: no se pudo abrir %s en el puerto %u\n", service->name, service->port);
+        vTaskDelete(NULL);
+        return;
+    }
+
+    histogram_reset(&service->proc_us);
+    printf("BENCH: %s en el puerto %u\n", service->name, service->port);
+
+    for (;;)
+    {
+        transport_addr_t peer_addr;
+        transport_conn_t *conn;
+
+        // Accept bloqueante: la escucha de este servicio no es no-bloqueante
+        if (transport->accept(listener, &conn, &peer_addr) != CY_RSLT_SUCCESS)
+        {
+            vTaskDelay(pdMS_TO_TICKS(100));
+            continue;
+        }
+
+        transport->set_recv_timeout(conn, BENCH_IDLE_TIMEOUT_MS);
+        transport->set_nodelay(conn, true); // Sin Nagle: el RTT del ping-pong y del eco no espera al ACK
+
+        uint64_t bytes_before = service->bytes_in + service->bytes_out;
+        uint32_t start_ms = xTaskGetTickCount() * portTICK_PERIOD_MS;
+
+        service->sessions++;
+        service->serve(service, conn);
+
+        uint32_t elapsed_ms = xTaskGetTickCount() * portTICK_PERIOD_MS - start_ms;
+        uint64_t bytes = service->bytes_in + service->bytes_out - bytes_before;
+        service->last_kbps = elapsed_ms ? (uint32_t)(bytes * 8 / elapsed_ms) : 0;
+        printf("BENCH: %s terminado, %lu bytes en %lu ms (%lu kbps)\n", service->name,
+               (unsigned long)(uint32_t)bytes, (unsigned long)elapsed_ms, (unsigned long)service->last_kbps);
+
+        transport->close(conn);
+        stack_monitor_sample_self();
+    }
+}
+
+static void bench_services_start(void)
+{
+    for (int i = 0; i < BENCH_SERVICE_COUNT; i++)
+    {
+        char task_name[configMAX_TASK_NAME_LEN];
+        snprintf(task_name, sizeof(task_name), "Bench_%s", bench_services[i].name);
+
+#if defined(APP_ZERO_HEAP)
+        TaskHandle_t handle = xTaskCreateStatic(bench_task, task_name, BENCH_TASK_STACK_SIZE,
+                                                &bench_services[i], BENCH_TASK_PRIORITY,
+                                                bench_stacks[i], &bench_tcbs[i]);
+        if (handle == NULL)
+#else
+        if (xTaskCreate(bench_task, task_name, BENCH_TASK_STACK_SIZE, &bench_services[i],
+                        BENCH_TASK_PRIORITY, NULL) != pdPASS)
+#endif
+        {
+            printf("BENCH: no se pudo crear la tarea %s\n", task_name);
+        }
+    }
+
+    stack_monitor_register("Bench_", BENCH_TASK_STACK_SIZE, NULL);
+}
+
+static int bench_report(char *buffer, size_t buffer_size, int len)
+{
+    len = report_append(buffer, buffer_size, len, "SERVICIO  PUERTO  SESIONES       B_IN      B_OUT  ULT_KBPS\n");
+    for (int i = 0; i < BENCH_SERVICE_COUNT; i++)
+    {
+        const bench_service_t *service = &bench_services[i];
+        len = report_append(buffer, buffer_size, len, "%-9s %6u %9lu %10lu %10lu %9lu\n",
+                            service->name, service->port, (unsigned long)service->sessions,
+                            (unsigned long)(uint32_t)service->bytes_in,
+                            (unsigned long)(uint32_t)service->bytes_out,
+                            (unsigned long)service->last_kbps);
+    }
+    for (int i = 0; i < BENCH_SERVICE_COUNT; i++)
+    {
+        if (bench_services[i].serve == bench_serve_pingpong)
+        {
+            len = histogram_report(&bench_services[i].proc_us, "pingpong en placa", "us",
+                                   buffer, buffer_size, len);
+        }
+    }
+    return len;
+}
+#endif
+
+// COMANDOS LOCALES DE DIAGNÓSTICO
+static int cmd_clients(client_info_t *client, char *buffer, size_t buffer_size)
+{
+    int len = report_append(buffer, buffer_size, 0, "=== CLIENTES (RTT en us) ===\n");
+    return clients_report(buffer, buffer_size, len);
+}
+
+static int cmd_stacks(client_info_t *client, char *buffer, size_t buffer_size)
+{
+    return stack_monitor_report(buffer, buffer_size);
+}
+
+static int cmd_heap(client_info_t *client, char *buffer, size_t buffer_size)
+{
+    return heap_monitor_report(buffer, buffer_size);
+}
+
+static int cmd_queues(client_info_t *client, char *buffer, size_t buffer_size)
+{
+    return queue_monitor_report(buffer, buffer_size);
+}
+
+static int cmd_latency(client_info_t *client, char *buffer, size_t buffer_size)
+{
+    return latency_monitor_report(buffer, buffer_size);
+}
+
+static int cmd_audio(client_info_t *client, char *buffer, size_t buffer_size)
+{
+    return ia_audio_report(buffer, buffer_size);
+}
+
+static int cmd_arena(client_info_t *client, char *buffer, size_t buffer_size)
+{
+    return ia_arena_report(buffer, buffer_size);
+}
+
+static int cmd_latency_reset(client_info_t *client, char *buffer, size_t buffer_size)
+{
+    latency_monitor_reset();
+    return report_append(buffer, buffer_size, 0, "LATENCY: histogramas reiniciados\n");
+}
+
+static int cmd_timing_on(client_info_t *client, char *buffer, size_t buffer_size)
+{
+    client->timing_echo = true;
+    return report_append(buffer, buffer_size, 0, "TIMING: latencia en cada respuesta\n");
+}
+
+static int cmd_timing_off(client_info_t *client, char *buffer, size_t buffer_size)
+{
+    client->timing_echo = false;
+    return report_append(buffer, buffer_size, 0, "TIMING: desactivado\n");
+}
+
+#if defined(APP_TRACE_RECORDER)
+static int cmd_trace_on(client_info_t *client, char *buffer, size_t buffer_size)
+{
+    trace_recorder_start();
+    return report_append(buffer, buffer_size, 0, "TRACE: grabando\n");
+}
+
+static int cmd_trace_off(client_info_t *client, char *buffer, size_t buffer_size)
+{
+    trace_recorder_stop();
+    return report_append(buffer, buffer_size, 0, "TRACE: detenido\n");
+}
+
+static bool trace_send(void *ctx, const char *data, size_t len)
+{
+    return client_send((client_info_t *)ctx, data, len) == CY_RSLT_SUCCESS;
+}
+
+// El volcado (~70 KB) se envía por bloques directamente desde el buffer de reporte
+static int cmd_trace_dump(client_info_t *client, char *buffer, size_t buffer_size)
+{
+    int count = trace_recorder_dump(buffer, buffer_size, trace_send, client);
+    printf("TCP: volcado de traza a cliente %lu: %d eventos\n", (unsigned long)client->client_id, count);
+    return 0;
+}
+#endif
+
+#if defined(APP_BENCH_SERVICES)
+static int cmd_bench(client_info_t *client, char *buffer, size_t buffer_size)
+{
+    int len = report_append(buffer, buffer_size, 0, "=== SERVICIOS DE PRUEBA ===\n");
+    return bench_report(buffer, buffer_size, len);
+}
+#endif
+
+static const local_command_t local_commands[] = {
+    {"CLIENTS", 7, cmd_clients},
+    {"STACKS", 6, cmd_stacks},
+    {"HEAP", 4, cmd_heap},
+    {"QUEUES", 6, cmd_queues},
+    {"LATENCY", 7, cmd_latency},
+    {"AUDIO", 5, cmd_audio},
+    {"ARENA", 5, cmd_arena},
+    {"LATENCY_RESET", 13, cmd_latency_reset},
+    {"TIMING_ON", 9, cmd_timing_on},
+    {"TIMING_OFF", 10, cmd_timing_off},
+#if defined(APP_TRACE_RECORDER)
+    {"TRACE_ON", 8, cmd_trace_on},
+    {"TRACE_OFF", 9, cmd_trace_off},
+    {"TRACE_DUMP", 10, cmd_trace_dump},
+#endif
+#if defined(APP_BENCH_SERVICES)
+    {"BENCH", 5, cmd_bench},
+#endif
+};
+
+#define LOCAL_COMMAND_COUNT (sizeof(local_commands) / sizeof(local_command_t))
+
+static void send_busy_message(client_info_t *client)
+{
+    const char *error_msg = "SERVIDOR OCUPADO - Intente nuevamente\n> ";
+
+    printf("TCP: ADVERTENCIA - Cola control llena, cliente %lu\n", (unsigned long)client->client_id);
+    client_send(client, error_msg, strlen(error_msg));
+}
+
+static int find_local_command(const char *cmd, size_t cmd_len)
+{
+    for (int i = 0; i < LOCAL_COMMAND_COUNT; i++)
+    {
+        if (cmd_len == local_commands[i].cmd_len &&
+            memcmp(cmd, local_commands[i].cmd, cmd_len) == 0)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static void run_local_command(client_info_t *client, int index)
+{
+    char *buffer = report_buffers[client - clients];
+    int len = local_commands[index].handler(client, buffer, REPORT_BUFFER_SIZE);
+    len = report_append(buffer, REPORT_BUFFER_SIZE, len, "> ");
+
+    client_send(client, buffer, len);
+}
+
+static void notify_client_task(client_info_t *client)
+{
+    xTaskNotifyGiveIndexed(client->task_handle, CLIENT_NOTIFY_RX);
+}
+
+// Parseo incremental: cada recepción (un recv, o una cadena de pbufs en el
+// hilo de red) es un comando. Se lee en el lugar donde llegó: solo se guarda
+// el token, que cabe en COMMAND_TOKEN_MAX; si es más largo ya es desconocido.
+static void client_rx_bytes(client_info_t *client, const uint8_t *data, uint32_t len)
+{
+    for (uint32_t i = 0; i < len; i++)
+    {
+        char c = (char)data[i];
+
+        if (client->rx_token_len == 0 && !client->rx_overflow && (c == ' ' || c == '\t'))
+        {
+            continue;
+        }
+        if (client->rx_token_len < COMMAND_TOKEN_MAX)
+        {
+            client->rx_token[client->rx_token_len++] = c;
+        }
+        else if (c != '\n' && c != '\r' && c != ' ')
+        {
+            client->rx_overflow = true;
+        }
+    }
+}
+
+// Fin de una recepción: despacha el token armado como comando local o como
+// descriptor para control. Fuera de la tarea del cliente (in_task = false) no
+// se puede bloquear ni escribir por UART: los comandos locales y el aviso de
+// cola llena quedan para la tarea.
+static void client_rx_complete(client_info_t *client, uint32_t recv_cycles, bool in_task)
+{
+    uint32_t token_len = client->rx_token_len;
+    char *token = client->rx_token;
+    bool overflow = client->rx_overflow;
+
+    client->rx_token_len = 0;
+    client->rx_overflow = false;
+    while (token_len > 0 && (token[token_len - 1] == '\n' || token[token_len - 1] == '\r' || token[token_len - 1] == ' '))
+    {
+        token_len--;
+    }
+    if (token_len == 0 && !overflow)
+    {
         return; // Comando vacÃ­o
+    }
+    token[token_len] = '\0';
 
-    // Logging optimizado con color
-    printf("\x1b[38;5;214m[%lu] CMD: %s\x1b[0m\n", client->client_id, cmd_start);
+    if (in_task)
+    {
+        // Logging optimizado con color
+        printf("\x1b[38;5;214m[%lu] CMD: %s%s\x1b[0m\n", (unsigned long)client->client_id, token,
+               overflow ? "..." : "");
+    }
+
+    int local = overflow ? -1 : find_local_command(token, token_len);
+    if (local >= 0)
+    {
+        if (in_task)
+        {
+            run_local_command(client, local); // Diagnóstico respondido por el servidor
+        }
+        else
+        {
+            if (atomic_exchange(&client->pending_local, (int8_t)local) >= 0)
+            {
+                atomic_fetch_add(&client->rx_drops, 1); // El anterior aún no se había atendido
+            }
+            notify_client_task(client);
+        }
+        return;
+    }
 
-    // Preparar mensaje de control optimizado
+    // A control solo va el descriptor; lo desconocido también, para su respuesta
     message_t control_msg = {
         .command = CMD_TCP_TO_CONTROL,
-        .value = client->client_id,
-        .data = {0}};
-
-    // Copiar comando de manera segura
-    size_t cmd_len = strlen(cmd_start);
-    if (cmd_len >= sizeof(control_msg.data))
+        .value = client->client_id};
+    if (overflow)
+    {
+        control_msg.cmd.opcode = COMMAND_OP_UNKNOWN;
+    }
+    else
     {
-        cmd_len = sizeof(control_msg.data) - 1;
+        command_parse(token, token_len, &control_msg.cmd);
     }
-    memcpy(control_msg.data, cmd_start, cmd_len);
-    control_msg.data[cmd_len] = '\0';
 
-    // EnvÃ­o no bloqueante al control
-    BaseType_t send_result = xQueueSend(client->params->queue_tcp_to_control,
-                                        &control_msg, pdMS_TO_TICKS(50));
+    control_msg.stamps[LATENCY_RECV] = recv_cycles;
+    latency_monitor_stamp(&control_msg, LATENCY_ENQUEUE);
+
+    // EnvÃ­o no bloqueante al control (sin espera desde el hilo de red)
+    BaseType_t send_result = queue_monitor_send(client->params->queue_tcp_to_control,
+                                                &control_msg, in_task ? pdMS_TO_TICKS(50) : 0);
 
     if (send_result != pdTRUE)
     {
-        printf("TCP: ADVERTENCIA - Cola control llena, cliente %lu\n", client->client_id);
+        if (in_task)
+        {
+            stats_begin(client);
+            client->stats.drops++;
+            stats_end(client);
+            send_busy_message(client);
+        }
+        else
+        {
+            atomic_fetch_add(&client->rx_drops, 1);
+            atomic_store(&client->pending_busy, true);
+            notify_client_task(client);
+        }
+    }
+}
 
-        // Enviar mensaje de error inmediato al cliente
-        const char *error_msg = "SERVIDOR OCUPADO - Intente nuevamente\n> ";
-        uint32_t bytes_sent;
-        cy_socket_send(client->socket, error_msg, strlen(error_msg),
-                       CY_SOCKET_FLAGS_NONE, &bytes_sent);
+// Manejador de recepción del transporte: corre en su contexto (hilo tcpip con
+// lwIP raw) y solo entrega comandos ya parseados
+static void client_rx_handler(void *ctx, const uint8_t *data, uint32_t len, bool last)
+{
+    client_info_t *client = (client_info_t *)ctx;
+
+    if (data == NULL)
+    {
+        atomic_store(&client->rx_closed, true);
+        notify_client_task(client);
+        return;
+    }
+
+    client->stats.bytes_in += len;
+    client_rx_bytes(client, data, len);
+    if (last)
+    {
+        client->last_activity = xTaskGetTickCount() * portTICK_PERIOD_MS;
+        client->stats.commands++;
+        client_rx_complete(client, cycle_counter_now(), false);
     }
 }
-static void client_task(void *param)
+
+// Lo que el manejador de recepción dejó para la tarea del cliente
+static void run_deferred_commands(client_info_t *client)
 {
+    int local = atomic_exchange(&client->pending_local, -1);
 
-    int client_index = (int)(intptr_t)param;
+    if (local >= 0)
+    {
+        printf("\x1b[38;5;214m[%lu] CMD: %s\x1b[0m\n", (unsigned long)client->client_id, local_commands[local].cmd);
+        run_local_command(client, local);
+    }
+    if (atomic_exchange(&client->pending_busy, false))
+    {
+        send_busy_message(client);
+    }
+}
+
+static void serve_client(int client_index)
+{
     client_info_t *client = &clients[client_index];
     char rx_buffer[BUFFER_SIZE];
     uint32_t bytes_received;
     cy_rslt_t result;
 
-    printf("[%lu] CLIENTE CONECTADO (slot %d)\n", client->client_id, client_index);
+    printf("[%lu] CLIENTE CONECTADO (slot %d)\n", (unsigned long)client->client_id, client_index);
 
     // Configurar timeouts optimizados
-    uint32_t rx_timeout = 200; // Timeout mÃ¡s corto para mejor responsividad
-    cy_socket_setsockopt(client->socket, CY_SOCKET_SOL_SOCKET,
-                         CY_SOCKET_SO_RCVTIMEO, &rx_timeout, sizeof(rx_timeout));
+    transport->set_recv_timeout(client->conn, 200); // Timeout mÃ¡s corto para mejor responsividad
 
-    client->state = CLIENT_STATE_ACTIVE;
     client->last_activity = xTaskGetTickCount() * portTICK_PERIOD_MS;
+    memset(&client->stats, 0, sizeof(client->stats));
+    atomic_store(&client->rx_drops, 0);
+    client->stats.connected_at_ms = client->last_activity;
+    client->broadcast_next = atomic_load_explicit(&broadcast_reserved, memory_order_acquire);
+    client->rx_token_len = 0;
+    client->rx_overflow = false;
+    atomic_store(&client->pending_local, -1);
+    atomic_store(&client->pending_busy, false);
+    atomic_store(&client->rx_closed, false);
 
     // Inicializar buffer circular para este cliente
     memset(&response_buffers[client_index], 0, sizeof(response_buffer_t));
 
+    // Publicar la ranura: a partir de aquí la ven los lectores sin bloqueo.
+    // Falla si el servidor pidió el cierre antes de arrancar.
+    slot_transition(client_index, CLIENT_STATE_CONNECTED, CLIENT_STATE_ACTIVE);
+
     // Mensaje de bienvenida optimizado
     const char *welcome =
         "\x1b[34m" // Yellow color
@@ -397,25 +1194,34 @@ static void client_task(void *param)
         "=== CONTROL SERVER v2.0 ===\n"
         "Comandos: 1_ON/OFF, 2_ON/OFF, 3_ON/OFF, 4_ON/OFF\n"
         "         ALL_ON, ALL_OFF, STATUS\n"
+        "Diagnostico: CLIENTS, STACKS, HEAP, QUEUES, LATENCY" DIAG_TRACE_HELP DIAG_BENCH_HELP "\n"
+        "             TIMING_ON/OFF (latencia en cada respuesta)\n"
         "Listo para comandos...\n> ";
-    uint32_t bytes_sent;
-    cy_socket_send(client->socket, welcome, strlen(welcome), CY_SOCKET_FLAGS_NONE, &bytes_sent);
+    client_send(client, welcome, strlen(welcome));
+
+    // Si el transporte lo permite, los comandos se parsean donde llegan y van
+    // directo a control; la tarea solo atiende respuestas y diagnósticos
+    client->rx_in_network = (transport->set_rx_handler(client->conn, client_rx_handler, client) == CY_RSLT_SUCCESS);
 
     // Variables de optimizaciÃ³n
-    uint32_t commands_processed = 0;
     uint32_t last_activity_check = 0;
 
-    while (client->state == CLIENT_STATE_ACTIVE)
+    while (client_state(client) == CLIENT_STATE_ACTIVE)
     {
         uint32_t current_time = xTaskGetTickCount() * portTICK_PERIOD_MS;
 
         // VerificaciÃ³n de timeout optimizada (cada 5 ciclos)
         if (++last_activity_check % 5 == 0)
         {
+            if (last_activity_check % 100 == 0)
+            {
+                stack_monitor_sample_self(); // Cada 100 ciclos: el barrido de pila no es gratis
+            }
+
             if ((current_time - client->last_activity) > CLIENT_TIMEOUT_MS)
             {
-                printf("Cliente %lu - timeout\n", client->client_id);
-                client->state = CLIENT_STATE_TIMEOUT;
+                printf("Cliente %lu - timeout\n", (unsigned long)client->client_id);
+                slot_transition(client_index, CLIENT_STATE_ACTIVE, CLIENT_STATE_TIMEOUT);
                 break;
             }
         }
@@ -425,17 +1231,39 @@ static void client_task(void *param)
         {
             send_buffered_responses(client, client_index);
         }
+        deliver_broadcasts(client);
+
+        if (client->rx_in_network)
+        {
+            run_deferred_commands(client);
+            if (atomic_load(&client->rx_closed))
+            {
+                printf("Cliente %lu desconectado\n", (unsigned long)client->client_id);
+                slot_transition(client_index, CLIENT_STATE_ACTIVE, CLIENT_STATE_ERROR);
+                break;
+            }
+
+            // La despiertan el manejador, control al encolar su respuesta y los
+            // broadcasts; solo si quedó una respuesta sin enviar se reintenta antes
+            ulTaskNotifyTakeIndexed(CLIENT_NOTIFY_RX, pdTRUE,
+                                    pdMS_TO_TICKS(response_buffers[client_index].count > 0 ? 5 : CLIENT_IDLE_WAKE_MS));
+            continue;
+        }
 
         // Recibir comandos del cliente
-        result = cy_socket_recv(client->socket, rx_buffer, sizeof(rx_buffer) - 1,
-                                CY_SOCKET_FLAGS_NONE, &bytes_received);
+        result = transport->recv(client->conn, rx_buffer, sizeof(rx_buffer), &bytes_received);
 
         if (result == CY_RSLT_SUCCESS && bytes_received > 0)
         {
+            uint32_t recv_cycles = cycle_counter_now();
             client->last_activity = current_time;
-            commands_processed++;
+            stats_begin(client);
+            client->stats.bytes_in += bytes_received;
+            client->stats.commands++;
+            stats_end(client);
 
-            process_client_command(client, rx_buffer, bytes_received);
+            client_rx_bytes(client, (const uint8_t *)rx_buffer, bytes_received);
+            client_rx_complete(client, recv_cycles, true);
         }
         else if (result == CY_RSLT_MODULE_SECURE_SOCKETS_TIMEOUT)
         {
@@ -447,8 +1275,8 @@ static void client_task(void *param)
             // Error de comunicaciÃ³n
             if (!handle_error_enhanced("Client recv", result, false))
             {
-                printf("Cliente %lu desconectado por error\n", client->client_id);
-                client->state = CLIENT_STATE_ERROR;
+                printf("Cliente %lu desconectado por error\n", (unsigned long)client->client_id);
+                slot_transition(client_index, CLIENT_STATE_ACTIVE, CLIENT_STATE_ERROR);
                 break;
             }
         }
@@ -458,90 +1286,142 @@ static void client_task(void *param)
     }
 
     printf("Cliente %lu finalizo - Comandos procesados: %lu\n",
-           client->client_id, commands_processed);
+           (unsigned long)client->client_id, (unsigned long)client->stats.commands);
 
-    // Limpiar buffer circular
-    memset(&response_buffers[client_index], 0, sizeof(response_buffer_t));
+    stack_monitor_sample_self();
+
+    // La tarea dueña cierra su propia conexión y libera la ranura
+    cleanup_client(client_index);
+}
+
+#if defined(APP_ZERO_HEAP)
+// Worker permanente de una ranura: espera una conexión aceptada y la atiende
+static void client_worker(void *param)
+{
+    int client_index = (int)(intptr_t)param;
 
-    // Cambiar estado para limpieza
-    if (xSemaphoreTake(clients_mutex, pdMS_TO_TICKS(1000)) == pdTRUE)
+    for (;;)
     {
-        client->state = CLIENT_STATE_DISCONNECTED;
-        xSemaphoreGive(clients_mutex);
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        serve_client(client_index);
     }
+}
+
+static bool create_client_workers(void)
+{
+    for (int i = 0; i < MAX_CLIENTS; i++)
+    {
+        char task_name[configMAX_TASK_NAME_LEN];
+        snprintf(task_name, sizeof(task_name), "Cliente_%d", i);
 
+        clients[i].task_handle = xTaskCreateStatic(client_worker, task_name, CLIENT_TASK_STACK_SIZE,
+                                                   (void *)(intptr_t)i, CLIENT_TASK_PRIORITY,
+                                                   client_stacks[i], &client_tcbs[i]);
+        if (clients[i].task_handle == NULL)
+        {
+            return false;
+        }
+        heap_monitor_watch_task(clients[i].task_handle);
+    }
+    return true;
+}
+#else
+// Tarea efímera: una por conexión
+static void client_task(void *param)
+{
+    serve_client((int)(intptr_t)param);
     vTaskDelete(NULL);
 }
+#endif
 
 // FUNCIONES DE CONEXIÃ“N (mantener las mismas pero actualizar accept_new_client)
 
+static void reject_client(transport_conn_t *new_conn, const char *reject_msg)
+{
+    uint32_t bytes_sent;
+    transport->send(new_conn, reject_msg, strlen(reject_msg), &bytes_sent);
+    transport->close(new_conn);
+}
+
 static void accept_new_client(void)
 {
-    cy_socket_sockaddr_t peer_addr;
-    uint32_t peer_len = sizeof(peer_addr);
-    cy_socket_t new_socket;
+    transport_addr_t peer_addr;
+    transport_conn_t *new_conn;
     cy_rslt_t result;
     BaseType_t task_result;
 
-    result = cy_socket_accept(server_socket, &peer_addr, &peer_len, &new_socket);
+    result = transport->accept(server_conn, &new_conn, &peer_addr);
 
     if (result == CY_RSLT_SUCCESS)
     {
         int client_index = obtener_ranura_cliente_libre();
 
-        if (client_index >= 0)
+        if (client_index < 0)
         {
-            if (xSemaphoreTake(clients_mutex, pdMS_TO_TICKS(1000)) == pdTRUE)
-            {
-                clients[client_index].socket = new_socket;
-                clients[client_index].state = CLIENT_STATE_CONNECTED;
-                clients[client_index].client_id = next_client_id++;
-                clients[client_index].peer_addr = peer_addr;
-                clients[client_index].last_activity = xTaskGetTickCount() * portTICK_PERIOD_MS;
-                clients[client_index].params = global_params; // Asignar parÃ¡metros
-
-                char task_name[20];
-                snprintf(task_name, sizeof(task_name), "Cliente_%lu", clients[client_index].client_id);
-
-                task_result = xTaskCreate(
-                    client_task,
-                    task_name,
-                    CLIENT_TASK_STACK_SIZE,
-                    (void *)(intptr_t)client_index,
-                    CLIENT_TASK_PRIORITY,
-                    &clients[client_index].task_handle);
-
-                if (task_result == pdPASS)
-                {
-                    printf("\x1b[1m");
-                    printf("\x1b[3m");
-                    printf("Nuevo cliente %lu conectado desde %lu.%lu.%lu.%lu (ranura %d)\n",
-                           clients[client_index].client_id,
-                           (peer_addr.ip_address.ip.v4 >> 0) & 0xFF,
-                           (peer_addr.ip_address.ip.v4 >> 8) & 0xFF,
-                           (peer_addr.ip_address.ip.v4 >> 16) & 0xFF,
-                           (peer_addr.ip_address.ip.v4 >> 24) & 0xFF,
-                           client_index);
-                    printf("\x1b[0m");
-                }
-                else
-                {
-                    printf("Error al crear la tarea del cliente\n");
-                    cleanup_client(client_index);
-                }
-
-                xSemaphoreGive(clients_mutex);
-            }
+            printf("Servidor lleno, rechazando nueva conexiÃ³n\n");
+            reject_client(new_conn, "Servidor lleno, intente mÃ¡s tarde\n");
+            return;
         }
-        else
+
+        // Admitir solo si la conexión (y la pila del cliente, salvo en modo sin
+        // heap) cabe en heap_5 sin agotar la reserva
+#if defined(APP_ZERO_HEAP)
+        size_t admission_bytes = CLIENT_HEAP_OVERHEAD_BYTES;
+#else
+        size_t admission_bytes = CLIENT_TASK_STACK_SIZE * sizeof(StackType_t) + CLIENT_HEAP_OVERHEAD_BYTES;
+#endif
+        if (!heap_monitor_can_admit(admission_bytes))
         {
-            printf("Servidor lleno, rechazando nueva conexiÃ³n\n");
-            const char *reject_msg = "Servidor lleno, intente mÃ¡s tarde\n";
-            uint32_t bytes_sent;
-            cy_socket_send(new_socket, reject_msg, strlen(reject_msg),
-                           CY_SOCKET_FLAGS_NONE, &bytes_sent);
-            cy_socket_disconnect(new_socket, 0);
-            cy_socket_delete(new_socket);
+            printf("Memoria insuficiente, rechazando nueva conexiÃ³n\n");
+            reject_client(new_conn, "Servidor sin memoria, intente mÃ¡s tarde\n");
+            cleanup_client(client_index); // Devolver la ranura reclamada
+            return;
+        }
+
+        // La ranura ya es nuestra (CONNECTED): se llena sin bloqueo y la tarea
+        // del cliente la publica como ACTIVE
+        {
+            clients[client_index].conn = new_conn;
+            clients[client_index].client_id = atomic_fetch_add(&next_client_id, 1);
+            clients[client_index].peer_addr = peer_addr;
+            clients[client_index].last_activity = xTaskGetTickCount() * portTICK_PERIOD_MS;
+            clients[client_index].params = global_params; // Asignar parÃ¡metros
+            clients[client_index].timing_echo = false;
+
+#if defined(APP_ZERO_HEAP)
+            // Despertar al worker estático de la ranura
+            task_result = xTaskNotifyGive(clients[client_index].task_handle);
+#else
+            char task_name[20];
+            snprintf(task_name, sizeof(task_name), "Cliente_%lu", (unsigned long)clients[client_index].client_id);
+
+            task_result = xTaskCreate(
+                client_task,
+                task_name,
+                CLIENT_TASK_STACK_SIZE,
+                (void *)(intptr_t)client_index,
+                CLIENT_TASK_PRIORITY,
+                &clients[client_index].task_handle);
+#endif
+
+            if (task_result == pdPASS)
+            {
+                printf("\x1b[1m");
+                printf("\x1b[3m");
+                printf("Nuevo cliente %lu conectado desde %lu.%lu.%lu.%lu (ranura %d)\n",
+                       (unsigned long)clients[client_index].client_id,
+                       (unsigned long)((peer_addr.ipv4 >> 0) & 0xFF),
+                       (unsigned long)((peer_addr.ipv4 >> 8) & 0xFF),
+                       (unsigned long)((peer_addr.ipv4 >> 16) & 0xFF),
+                       (unsigned long)((peer_addr.ipv4 >> 24) & 0xFF),
+                       client_index);
+                printf("\x1b[0m");
+            }
+            else
+            {
+                printf("Error al crear la tarea del cliente\n");
+                cleanup_client(client_index);
+            }
         }
     }
     else if (result != CY_RSLT_MODULE_SECURE_SOCKETS_TIMEOUT)
@@ -579,11 +1459,10 @@ static cy_rslt_t connect_wifi(void)
             printf("Conectado a WiFi\n");
             printf("\x1b[33m");
             printf("IP: %lu.%lu.%lu.%lu\n",
-                   (ip.ip.v4 >> 0) & 0xFF, (ip.ip.v4 >> 8) & 0xFF,
-                   (ip.ip.v4 >> 16) & 0xFF, (ip.ip.v4 >> 24) & 0xFF);
+                   (unsigned long)((ip.ip.v4 >> 0) & 0xFF), (unsigned long)((ip.ip.v4 >> 8) & 0xFF),
+                   (unsigned long)((ip.ip.v4 >> 16) & 0xFF), (unsigned long)((ip.ip.v4 >> 24) & 0xFF));
 
-            server_addr.ip_address.ip.v4 = ip.ip.v4;
-            server_addr.ip_address.version = CY_SOCKET_IP_VER_V4;
+            server_addr.ipv4 = ip.ip.v4;
             server_addr.port = TCP_PORT;
             return CY_RSLT_SUCCESS;
         }
@@ -600,37 +1479,32 @@ static cy_rslt_t connect_wifi(void)
     return result;
 }
 
+static void wake_server_task(void *ctx)
+{
+    xTaskNotifyGive((TaskHandle_t)ctx);
+}
+
 static cy_rslt_t create_server_socket(void)
 {
     cy_rslt_t result;
 
-    result = cy_socket_create(CY_SOCKET_DOMAIN_AF_INET,
-                              CY_SOCKET_TYPE_STREAM,
-                              CY_SOCKET_IPPROTO_TCP,
-                              &server_socket);
+    // Escucha no bloqueante: el lazo del servidor sondea accept
+    result = transport->listen(&server_addr, MAX_CLIENTS, true, &server_conn);
     if (result != CY_RSLT_SUCCESS)
     {
         return result;
     }
 
-    uint32_t nonblocking = 1;
-    cy_socket_setsockopt(server_socket, CY_SOCKET_SOL_SOCKET,
-                         CY_SOCKET_SO_NONBLOCK, &nonblocking, sizeof(nonblocking));
-
-    result = cy_socket_bind(server_socket, &server_addr, sizeof(server_addr));
-    if (result != CY_RSLT_SUCCESS)
+    // Si el backend avisa de conexiones entrantes, el lazo se despierta
+    // enseguida en vez de esperar la próxima vuelta
+    if (transport->set_ready_callback(server_conn, wake_server_task,
+                                      xTaskGetCurrentTaskHandle()) != CY_RSLT_SUCCESS)
     {
-        return result;
-    }
-
-    result = cy_socket_listen(server_socket, MAX_CLIENTS);
-    if (result != CY_RSLT_SUCCESS)
-    {
-        return result;
+        printf("Transporte %s sin aviso de conexiones: accept por sondeo\n", transport->name);
     }
 
-    printf("Puerto: %d (Maximo %d clientes)\n",
-           TCP_PORT, MAX_CLIENTS);
+    printf("Puerto: %d (Maximo %d clientes, transporte %s)\n",
+           TCP_PORT, MAX_CLIENTS, transport->name);
     return CY_RSLT_SUCCESS;
 }
 
@@ -639,32 +1513,41 @@ static cy_rslt_t create_server_socket(void)
 static void print_server_status(void)
 {
     static uint32_t last_status_time = 0;
+    static char status_buffer[REPORT_BUFFER_SIZE];
     uint32_t current_time = xTaskGetTickCount() * portTICK_PERIOD_MS;
 
     if ((current_time - last_status_time) > 10000)
     {
         int connected_clients = 0;
 
-        if (xSemaphoreTake(clients_mutex, pdMS_TO_TICKS(100)) == pdTRUE)
+        for (int i = 0; i < MAX_CLIENTS; i++)
         {
-            for (int i = 0; i < MAX_CLIENTS; i++)
+            if (SLOT_STATE(slot_load(i)) == CLIENT_STATE_ACTIVE)
             {
-                if (clients[i].state == CLIENT_STATE_ACTIVE)
-                {
-                    connected_clients++;
-                }
+                connected_clients++;
             }
-            xSemaphoreGive(clients_mutex);
         }
 
         printf("\x1b[33m");
-        printf("\n=== ESTADO DEL SERVIDOR [%lu] ===\n", xTaskGetTickCount());
+        printf("\n=== ESTADO DEL SERVIDOR [%lu] ===\n", (unsigned long)xTaskGetTickCount());
         printf("Clientes activos: %d/%d\n", connected_clients, MAX_CLIENTS);
-        printf("Total de clientes atendidos: %lu\n", next_client_id - 1);
+        if (connected_clients > 0)
+        {
+            clients_report(status_buffer, sizeof(status_buffer), 0);
+            printf("%s", status_buffer);
+        }
+        printf("Total de clientes atendidos: %lu\n", (unsigned long)(atomic_load(&next_client_id) - 1));
         printf("Estadisticas de errores - Recup: %lu, Red: %lu, CrÃ­t: %lu\n",
-               error_stats.recoverable_errors, error_stats.network_errors,
-               error_stats.critical_errors);
-        printf("Tiempo de funcionamiento: %lu segundos\n", current_time / 1000);
+               (unsigned long)error_stats.recoverable_errors, (unsigned long)error_stats.network_errors,
+               (unsigned long)error_stats.critical_errors);
+        printf("Tiempo de funcionamiento: %lu segundos\n", (unsigned long)(current_time / 1000));
+
+        HeapStats_t heap_stats;
+        heap_monitor_get_stats(&heap_stats);
+        printf("Heap libre: %u bytes (min %u, bloque mayor %u)\n",
+               (unsigned)heap_stats.xAvailableHeapSpaceInBytes,
+               (unsigned)heap_stats.xMinimumEverFreeBytesRemaining,
+               (unsigned)heap_stats.xSizeOfLargestFreeBlockInBytes);
         printf("==================================\n\n");
 
         last_status_time = current_time;
@@ -681,17 +1564,21 @@ void tarea_TCPserver(void *arg)
     memset(clients, 0, sizeof(clients));
     for (int i = 0; i < MAX_CLIENTS; i++)
     {
-        clients[i].socket = CY_SOCKET_INVALID_HANDLE;
-        clients[i].state = CLIENT_STATE_DISCONNECTED;
+        clients[i].conn = NULL;
+        atomic_init(&clients[i].slot, SLOT_WORD(0, CLIENT_STATE_DISCONNECTED));
     }
 
-    clients_mutex = xSemaphoreCreateMutex();
-    if (clients_mutex == NULL)
+#if defined(APP_ZERO_HEAP)
+    if (!create_client_workers())
     {
-        printf("Error al crear el mutex de clientes\n");
+        printf("Error al crear los workers de clientes\n");
         vTaskDelete(NULL);
         return;
     }
+#endif
+
+    // Las tareas de cliente se muestrean a sí mismas
+    stack_monitor_register("Cliente_", CLIENT_TASK_STACK_SIZE, NULL);
 
     do
     {
@@ -704,7 +1591,7 @@ void tarea_TCPserver(void *arg)
         }
     } while (result != CY_RSLT_SUCCESS);
 
-    result = cy_socket_init();
+    result = transport->init();
     if (result != CY_RSLT_SUCCESS)
     {
         handle_error_enhanced("InicializaciÃ³n de sockets", result, true);
@@ -726,31 +1613,61 @@ void tarea_TCPserver(void *arg)
 
     server_running = true;
 
+#if defined(APP_BENCH_SERVICES)
+    bench_services_start();
+#endif
+
+    // A partir de aquí el camino de comandos no debe asignar memoria; aceptar
+    // una conexión (sockets y mailboxes de lwIP) es la única excepción
+    heap_monitor_steady_state_begin();
+
+    uint32_t last_stack_sample = 0;
+
     while (server_running)
     {
+        heap_monitor_allow_begin();
         accept_new_client();
-        cleanup_disconnected_clients();
+        heap_monitor_allow_end();
         print_server_status();
-        vTaskDelay(pdMS_TO_TICKS(100));
+
+        uint32_t now = xTaskGetTickCount() * portTICK_PERIOD_MS;
+        if ((now - last_stack_sample) >= STACK_MONITOR_PERIOD_MS)
+        {
+            stack_monitor_sample();
+            last_stack_sample = now;
+        }
+
+        // wake_server_task acorta la espera cuando llega una conexión
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(100));
     }
 
     printf("Cerrando servidor...\n");
 
-    if (xSemaphoreTake(clients_mutex, pdMS_TO_TICKS(5000)) == pdTRUE)
+    // Pedir el cierre a cada cliente; cada tarea libera su propia ranura
+    for (int i = 0; i < MAX_CLIENTS; i++)
     {
+        slot_transition(i, CLIENT_STATE_ACTIVE, CLIENT_STATE_ERROR);
+        slot_transition(i, CLIENT_STATE_CONNECTED, CLIENT_STATE_ERROR);
+    }
+    for (int wait_ms = 0; wait_ms < 5000; wait_ms += 100)
+    {
+        int busy = 0;
         for (int i = 0; i < MAX_CLIENTS; i++)
         {
-            cleanup_client(i);
+            busy += (SLOT_STATE(slot_load(i)) != CLIENT_STATE_DISCONNECTED);
+        }
+        if (busy == 0)
+        {
+            break;
         }
-        xSemaphoreGive(clients_mutex);
+        vTaskDelay(pdMS_TO_TICKS(100));
     }
 
-    if (server_socket != CY_SOCKET_INVALID_HANDLE)
+    if (server_conn != NULL)
     {
-        cy_socket_disconnect(server_socket, 0);
-        cy_socket_delete(server_socket);
+        transport->close(server_conn);
+        server_conn = NULL;
     }
 
-    vSemaphoreDelete(clients_mutex);
     vTaskDelete(NULL);
 }
\ No newline at end of file
@@ -1,6 +1,11 @@
 #ifndef TCP_SERVER_H_
 #define TCP_SERVER_H_
 
+#include <stdint.h>
+
 void tarea_TCPserver(void *arg);
 
+// Avisa a la tarea del cliente que control encoló su respuesta (0 = broadcast)
+void tcp_server_notify_reply(uint32_t client_id);
+
 #endif /* TCP_SERVER_H_ */
\ No newline at end of file
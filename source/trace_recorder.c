@@ -0,0 +1,262 @@
+#include "cyhal.h"
+#include <FreeRTOS.h>
+#include <task.h>
+#include <queue.h>
+#include <string.h>
+#include <stdio.h>
+#include "trace_recorder.h"
+#include "cycle_counter.h"
+#include "report.h"
+#include "config.h"
+
+#if defined(APP_TRACE_RECORDER)
+
+#include "trace_recorder_hooks.h"
+
+#define TRACE_TASK_SLOTS 64      // Tabla de nombres: sondeo lineal desde uxTCBNumber % 64
+#define TRACE_TASK_ISR 0xFF      // Evento originado en una interrupción
+#define TRACE_MAX_QUEUES 15      // Números de cola 1..15 (0 = no trazada)
+#define TRACE_EVENTS_PER_LINE 32 // 16 caracteres hex por evento
+
+#if (TRACE_BUFFER_EVENTS & (TRACE_BUFFER_EVENTS - 1)) != 0
+#error "TRACE_BUFFER_EVENTS debe ser potencia de 2"
+#endif
+
+// 8 bytes por evento; el visor reconstruye el tiempo absoluto desenrollando
+// cycles (se asume al menos un evento cada 2^32 ciclos). La tarea de cada
+// evento es la del último cambio de contexto: los cambios y los eventos de
+// prioridad llevan el uxTCBNumber en arg, así que una tarea nueva nunca
+// hereda el nombre de otra que ya terminó.
+typedef struct
+{
+    uint32_t cycles;
+    uint8_t type; // TRACE_EVT_*
+    uint8_t task; // TRACE_TASK_ISR, prioridad (eventos de herencia) o 0
+    uint16_t arg; // uxTCBNumber, número de cola, id de ISR o código de usuario
+} trace_event_t;
+
+typedef struct
+{
+    uint32_t number; // uxTCBNumber (0 = entrada libre)
+    char name[configMAX_TASK_NAME_LEN];
+} trace_task_name_t;
+
+static trace_event_t events[TRACE_BUFFER_EVENTS];
+static volatile uint32_t event_head = 0; // Total de eventos escritos
+static volatile bool recording = false;
+static trace_task_name_t task_names[TRACE_TASK_SLOTS];
+static const char *queue_names[TRACE_MAX_QUEUES + 1];
+static uint32_t queue_count = 0;
+
+static inline void record(uint8_t type, uint8_t task, uint16_t arg)
+{
+    if (!recording)
+    {
+        return;
+    }
+
+    // Máscara de BASEPRI: válida desde tareas, ISR y secciones críticas del kernel
+    UBaseType_t mask = portSET_INTERRUPT_MASK_FROM_ISR();
+    trace_event_t *evt = &events[event_head & (TRACE_BUFFER_EVENTS - 1)];
+    event_head++;
+    evt->cycles = cycle_counter_now();
+    evt->type = type;
+    evt->task = task;
+    evt->arg = arg;
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+}
+
+static bool is_mutex(uint32_t queue_type)
+{
+    return queue_type == queueQUEUE_TYPE_MUTEX || queue_type == queueQUEUE_TYPE_RECURSIVE_MUTEX;
+}
+
+void trace_recorder_init(void)
+{
+    cycle_counter_init();
+    event_head = 0;
+    recording = true;
+}
+
+void trace_recorder_name_queue(QueueHandle_t queue, const char *name)
+{
+    if (queue == NULL || queue_count >= TRACE_MAX_QUEUES)
+    {
+        return;
+    }
+
+    queue_count++;
+    queue_names[queue_count] = name;
+    vQueueSetQueueNumber(queue, queue_count);
+    vQueueAddToRegistry(queue, name); // Visible también desde el depurador
+}
+
+void trace_recorder_start(void)
+{
+    recording = true;
+}
+
+void trace_recorder_stop(void)
+{
+    recording = false;
+}
+
+// HOOKS DEL KERNEL (trace_recorder_hooks.h)
+
+void trace_recorder_task_switched_in(uint32_t task_number, const char *task_name)
+{
+    uint32_t home = task_number % TRACE_TASK_SLOTS;
+    trace_task_name_t *entry = &task_names[home]; // Tabla llena: se reemplaza la entrada base
+
+    // Sondeo lineal: dos tareas vivas con el mismo resto no se pisan el nombre
+    for (uint32_t probe = 0; probe < TRACE_TASK_SLOTS; probe++)
+    {
+        trace_task_name_t *candidate = &task_names[(home + probe) % TRACE_TASK_SLOTS];
+        if (candidate->number == task_number || candidate->number == 0)
+        {
+            entry = candidate;
+            break;
+        }
+    }
+
+    // Copia el nombre solo la primera vez: la tarea puede no existir al volcar
+    if (entry->number != task_number)
+    {
+        entry->number = task_number;
+        strncpy(entry->name, task_name, configMAX_TASK_NAME_LEN - 1);
+    }
+
+    record(TRACE_EVT_TASK_SWITCH, 0, (uint16_t)task_number);
+}
+
+void trace_recorder_queue_event(uint32_t type, uint32_t queue_number, uint32_t queue_type, uint32_t from_isr)
+{
+    if (queue_number == 0)
+    {
+        return; // Colas de lwIP, WHD y timers: demasiado ruido
+    }
+
+    if (is_mutex(queue_type))
+    {
+        switch (type)
+        {
+        case TRACE_EVT_QUEUE_SEND:
+            type = TRACE_EVT_MUTEX_GIVE;
+            break;
+        case TRACE_EVT_QUEUE_RECEIVE:
+            type = TRACE_EVT_MUTEX_TAKE;
+            break;
+        case TRACE_EVT_QUEUE_BLOCK_RECV:
+            type = TRACE_EVT_MUTEX_BLOCK;
+            break;
+        case TRACE_EVT_QUEUE_RECV_FAIL:
+            type = TRACE_EVT_MUTEX_TIMEOUT;
+            break;
+        default:
+            break;
+        }
+    }
+
+    record(type, from_isr ? TRACE_TASK_ISR : 0, queue_number);
+}
+
+void trace_recorder_priority_event(uint32_t type, uint32_t task_number, uint32_t priority)
+{
+    // La tarea afectada es la dueña del mutex; la actual es la que espera
+    record(type, (uint8_t)priority, (uint16_t)task_number);
+}
+
+void trace_recorder_isr_enter(uint16_t isr_id)
+{
+    record(TRACE_EVT_ISR_ENTER, TRACE_TASK_ISR, isr_id);
+}
+
+void trace_recorder_isr_exit(uint16_t isr_id)
+{
+    record(TRACE_EVT_ISR_EXIT, TRACE_TASK_ISR, isr_id);
+}
+
+void trace_recorder_user_event(uint16_t code)
+{
+    record(TRACE_EVT_USER, 0, code);
+}
+
+// VOLCADO
+
+static bool flush(char *buffer, int *len, trace_sink_fn_t sink, void *ctx)
+{
+    bool ok = (*len == 0) || sink(ctx, buffer, *len);
+    *len = 0;
+    return ok;
+}
+
+int trace_recorder_dump(char *buffer, size_t buffer_size, trace_sink_fn_t sink, void *ctx)
+{
+    bool was_recording = recording;
+    recording = false;
+
+    uint32_t head = event_head;
+    uint32_t count = (head > TRACE_BUFFER_EVENTS) ? TRACE_BUFFER_EVENTS : head;
+    uint32_t first = head - count;
+    int len = 0;
+    bool ok = true;
+
+    // Cabecera: frecuencia del contador y eventos perdidos por sobrescritura
+    len = report_append(buffer, buffer_size, len, "TRACE_BEGIN hz=%lu events=%lu lost=%lu\n",
+                        (unsigned long)SystemCoreClock, (unsigned long)count,
+                        (unsigned long)(head - count));
+
+    for (int i = 0; i < TRACE_TASK_SLOTS && ok; i++)
+    {
+        if (task_names[i].number != 0) // uxTCBNumber empieza en 1
+        {
+            if (buffer_size - len < 64)
+            {
+                ok = flush(buffer, &len, sink, ctx);
+            }
+            len = report_append(buffer, buffer_size, len, "T %lu %s\n",
+                                (unsigned long)(task_names[i].number & 0xFFFF), task_names[i].name);
+        }
+    }
+
+    for (uint32_t q = 1; q <= queue_count && ok; q++)
+    {
+        if (buffer_size - len < 64)
+        {
+            ok = flush(buffer, &len, sink, ctx);
+        }
+        len = report_append(buffer, buffer_size, len, "Q %lu %s\n", (unsigned long)q, queue_names[q]);
+    }
+
+    // Eventos en hex: cycles(8) type(2) task(2) arg(4)
+    for (uint32_t n = 0; n < count && ok; n += TRACE_EVENTS_PER_LINE)
+    {
+        if (buffer_size - len < TRACE_EVENTS_PER_LINE * 16 + 4)
+        {
+            ok = flush(buffer, &len, sink, ctx);
+        }
+
+        len = report_append(buffer, buffer_size, len, "E ");
+        for (uint32_t k = n; k < count && k < n + TRACE_EVENTS_PER_LINE; k++)
+        {
+            const trace_event_t *evt = &events[(first + k) & (TRACE_BUFFER_EVENTS - 1)];
+            len = report_append(buffer, buffer_size, len, "%08lx%02x%02x%04x",
+                                (unsigned long)evt->cycles, evt->type, evt->task, evt->arg);
+        }
+        len = report_append(buffer, buffer_size, len, "\n");
+    }
+
+    if (ok)
+    {
+        len = report_append(buffer, buffer_size, len, "TRACE_END\n");
+        ok = flush(buffer, &len, sink, ctx);
+    }
+
+    // Los nombres se conservan: las tareas vivas no vuelven a nombrarse
+    event_head = 0;
+    recording = was_recording;
+
+    return ok ? (int)count : -1;
+}
+
+#endif /* APP_TRACE_RECORDER */
@@ -0,0 +1,60 @@
+#ifndef TRACE_RECORDER_H_
+#define TRACE_RECORDER_H_
+
+#include <FreeRTOS.h>
+#include <queue.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Registrador de trazas del kernel en RAM (solo con APP_TRACE_RECORDER).
+// Guarda cambios de contexto, operaciones sobre colas y mutex registrados y
+// entradas a ISR en un buffer circular de TRACE_BUFFER_EVENTS eventos con
+// marca de tiempo del contador de ciclos. Sin el flag todo compila a nada.
+
+// Ids de las ISR propias (argumento de TRACE_ISR_ENTER/EXIT). Solo se
+// instrumenta el callback del PDM; las interrupciones de WHD/SDIO y del tick
+// no aparecen en la fila ISR, salvo sus operaciones *FromISR sobre colas
+// registradas.
+#define TRACE_ISR_PDM 1 // Fin de bloque del DMA del micrófono (ia.c)
+
+// Destino del volcado: devuelve false para abortarlo (p. ej. socket cerrado)
+typedef bool (*trace_sink_fn_t)(void *ctx, const char *data, size_t len);
+
+#if defined(APP_TRACE_RECORDER)
+
+// Habilita el contador de ciclos y arranca la grabación (antes del scheduler)
+void trace_recorder_init(void);
+
+// Asigna número y nombre a una cola o mutex; solo se trazan los registrados
+void trace_recorder_name_queue(QueueHandle_t queue, const char *name);
+
+void trace_recorder_start(void);
+void trace_recorder_stop(void);
+
+// Marcan entrada y salida de los callbacks de interrupción propios
+void trace_recorder_isr_enter(uint16_t isr_id);
+void trace_recorder_isr_exit(uint16_t isr_id);
+
+// Marca puntual desde una tarea (code se ve como argumento en el visor)
+void trace_recorder_user_event(uint16_t code);
+
+// Pausa la grabación, vuelca el buffer como texto por bloques de hasta
+// buffer_size bytes, lo vacía y reanuda. Devuelve los eventos volcados.
+int trace_recorder_dump(char *buffer, size_t buffer_size, trace_sink_fn_t sink, void *ctx);
+
+#define TRACE_NAME_QUEUE(queue, name) trace_recorder_name_queue((queue), (name))
+#define TRACE_ISR_ENTER(isr_id) trace_recorder_isr_enter(isr_id)
+#define TRACE_ISR_EXIT(isr_id) trace_recorder_isr_exit(isr_id)
+#define TRACE_USER_EVENT(code) trace_recorder_user_event(code)
+
+#else
+
+#define TRACE_NAME_QUEUE(queue, name) ((void)(queue), (void)(name))
+#define TRACE_ISR_ENTER(isr_id) ((void)0)
+#define TRACE_ISR_EXIT(isr_id) ((void)0)
+#define TRACE_USER_EVENT(code) ((void)0)
+
+#endif /* APP_TRACE_RECORDER */
+
+#endif /* TRACE_RECORDER_H_ */
@@ -0,0 +1,57 @@
+#ifndef TRACE_RECORDER_HOOKS_H_
+#define TRACE_RECORDER_HOOKS_H_
+
+/* Hooks de traza del kernel para trace_recorder.c. Se incluye desde
+ * FreeRTOSConfig.h solo con APP_TRACE_RECORDER; los macros se expanden dentro
+ * de tasks.c y queue.c, donde pxCurrentTCB y pxQueue son visibles
+ * (uxTCBNumber, uxQueueNumber y ucQueueType requieren configUSE_TRACE_FACILITY). */
+
+#include <stdint.h>
+
+#define TRACE_EVT_TASK_SWITCH      1
+#define TRACE_EVT_QUEUE_SEND       2
+#define TRACE_EVT_QUEUE_RECEIVE    3
+#define TRACE_EVT_QUEUE_BLOCK_SEND 4
+#define TRACE_EVT_QUEUE_BLOCK_RECV 5
+#define TRACE_EVT_QUEUE_SEND_FAIL  6
+#define TRACE_EVT_QUEUE_RECV_FAIL  7
+#define TRACE_EVT_MUTEX_GIVE       8
+#define TRACE_EVT_MUTEX_TAKE       9
+#define TRACE_EVT_MUTEX_BLOCK      10
+#define TRACE_EVT_MUTEX_TIMEOUT    11
+#define TRACE_EVT_PRIO_INHERIT     12
+#define TRACE_EVT_PRIO_DISINHERIT  13
+#define TRACE_EVT_ISR_ENTER        14
+#define TRACE_EVT_ISR_EXIT         15
+#define TRACE_EVT_USER             16
+
+extern void trace_recorder_task_switched_in(uint32_t task_number, const char *task_name);
+extern void trace_recorder_queue_event(uint32_t type, uint32_t queue_number, uint32_t queue_type, uint32_t from_isr);
+extern void trace_recorder_priority_event(uint32_t type, uint32_t task_number, uint32_t priority);
+
+#define traceTASK_SWITCHED_IN() \
+    trace_recorder_task_switched_in(pxCurrentTCB->uxTCBNumber, pxCurrentTCB->pcTaskName)
+
+#define traceQUEUE_SEND(pxQueue) \
+    trace_recorder_queue_event(TRACE_EVT_QUEUE_SEND, (pxQueue)->uxQueueNumber, (pxQueue)->ucQueueType, 0)
+#define traceQUEUE_SEND_FAILED(pxQueue) \
+    trace_recorder_queue_event(TRACE_EVT_QUEUE_SEND_FAIL, (pxQueue)->uxQueueNumber, (pxQueue)->ucQueueType, 0)
+#define traceQUEUE_RECEIVE(pxQueue) \
+    trace_recorder_queue_event(TRACE_EVT_QUEUE_RECEIVE, (pxQueue)->uxQueueNumber, (pxQueue)->ucQueueType, 0)
+#define traceQUEUE_RECEIVE_FAILED(pxQueue) \
+    trace_recorder_queue_event(TRACE_EVT_QUEUE_RECV_FAIL, (pxQueue)->uxQueueNumber, (pxQueue)->ucQueueType, 0)
+#define traceBLOCKING_ON_QUEUE_SEND(pxQueue) \
+    trace_recorder_queue_event(TRACE_EVT_QUEUE_BLOCK_SEND, (pxQueue)->uxQueueNumber, (pxQueue)->ucQueueType, 0)
+#define traceBLOCKING_ON_QUEUE_RECEIVE(pxQueue) \
+    trace_recorder_queue_event(TRACE_EVT_QUEUE_BLOCK_RECV, (pxQueue)->uxQueueNumber, (pxQueue)->ucQueueType, 0)
+#define traceQUEUE_SEND_FROM_ISR(pxQueue) \
+    trace_recorder_queue_event(TRACE_EVT_QUEUE_SEND, (pxQueue)->uxQueueNumber, (pxQueue)->ucQueueType, 1)
+#define traceQUEUE_RECEIVE_FROM_ISR(pxQueue) \
+    trace_recorder_queue_event(TRACE_EVT_QUEUE_RECEIVE, (pxQueue)->uxQueueNumber, (pxQueue)->ucQueueType, 1)
+
+#define traceTASK_PRIORITY_INHERIT(pxTCBOfMutexHolder, uxInheritedPriority) \
+    trace_recorder_priority_event(TRACE_EVT_PRIO_INHERIT, (pxTCBOfMutexHolder)->uxTCBNumber, (uxInheritedPriority))
+#define traceTASK_PRIORITY_DISINHERIT(pxTCBOfMutexHolder, uxOriginalPriority) \
+    trace_recorder_priority_event(TRACE_EVT_PRIO_DISINHERIT, (pxTCBOfMutexHolder)->uxTCBNumber, (uxOriginalPriority))
+
+#endif /* TRACE_RECORDER_HOOKS_H_ */
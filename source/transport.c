@@ -0,0 +1,27 @@
+#include "transport.h"
+
+cy_rslt_t transport_send_all(const transport_ops_t *ops, transport_conn_t *conn,
+                             const void *data, uint32_t len, uint32_t *total_sent)
+{
+    const uint8_t *ptr = (const uint8_t *)data;
+
+    *total_sent = 0;
+    while (len > 0)
+    {
+        uint32_t sent = 0;
+        cy_rslt_t result = ops->send(conn, ptr, len, &sent);
+
+        *total_sent += sent;
+        if (result != CY_RSLT_SUCCESS)
+        {
+            return result;
+        }
+        if (sent == 0)
+        {
+            return CY_RSLT_MODULE_SECURE_SOCKETS_CLOSED;
+        }
+        ptr += sent;
+        len -= sent;
+    }
+    return CY_RSLT_SUCCESS;
+}
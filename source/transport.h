@@ -0,0 +1,74 @@
+#ifndef TRANSPORT_H_
+#define TRANSPORT_H_
+
+#include "cyhal.h"
+#include "cy_secure_sockets.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// Capa de transporte del servidor: tcp_server.c solo usa estas operaciones y
+// el backend se elige al compilar:
+//   transport_secure_sockets  cy_secure_sockets (por defecto)
+//   transport_posix           sockets BSD de la simulación en Linux (APP_TRANSPORT_POSIX)
+//   transport_lwip            API raw de lwIP, callbacks en el hilo tcpip (APP_TRANSPORT_LWIP)
+// Todos los backends devuelven los códigos de cy_secure_sockets, así el
+// manejo de errores del servidor (classify_error) no depende del backend.
+
+#define TRANSPORT_WAIT_FOREVER CY_SOCKET_NEVER_TIMEOUT
+
+typedef struct transport_conn transport_conn_t; // La define cada backend
+
+typedef struct
+{
+    uint32_t ipv4; // Orden de red, como lwIP
+    uint16_t port;
+} transport_addr_t;
+
+// Hay una conexión por aceptar (escucha) o datos/cierre por leer (conexión).
+// Corre en el contexto del backend, no en la tarea dueña: breve y sin bloquear.
+typedef void (*transport_ready_fn_t)(void *ctx);
+
+// Recepción en el contexto del backend, sin pasar por recv(): se llama una vez
+// por segmento de lo que llegó junto (last en el último) y con data == NULL
+// si el otro extremo cerró o hubo un error. El buffer solo vale durante la
+// llamada. Mismas restricciones que transport_ready_fn_t.
+typedef void (*transport_rx_fn_t)(void *ctx, const uint8_t *data, uint32_t len, bool last);
+
+typedef struct
+{
+    const char *name;
+    cy_rslt_t (*init)(void);
+    // Con nonblocking, accept devuelve TIMEOUT de inmediato si no hay conexiones
+    cy_rslt_t (*listen)(const transport_addr_t *addr, int backlog, bool nonblocking,
+                        transport_conn_t **listener);
+    cy_rslt_t (*accept)(transport_conn_t *listener, transport_conn_t **conn, transport_addr_t *peer);
+    // Devuelve TIMEOUT si no llegó nada en el timeout de recepción, CLOSED al cerrar el otro extremo
+    cy_rslt_t (*recv)(transport_conn_t *conn, void *data, uint32_t size, uint32_t *received);
+    // Puede enviar menos de len: ver transport_send_all
+    cy_rslt_t (*send)(transport_conn_t *conn, const void *data, uint32_t len, uint32_t *sent);
+    cy_rslt_t (*set_recv_timeout)(transport_conn_t *conn, uint32_t timeout_ms);
+    cy_rslt_t (*set_nodelay)(transport_conn_t *conn, bool nodelay);
+    // Opcional: PROTOCOL_NOT_SUPPORTED si el backend solo permite sondear
+    cy_rslt_t (*set_ready_callback)(transport_conn_t *conn, transport_ready_fn_t fn, void *ctx);
+    // Opcional, igual que el anterior; con un manejador instalado recv() ya no entrega datos
+    cy_rslt_t (*set_rx_handler)(transport_conn_t *conn, transport_rx_fn_t fn, void *ctx);
+    void (*close)(transport_conn_t *conn);
+} transport_ops_t;
+
+extern const transport_ops_t transport_secure_sockets;
+#if defined(APP_TRANSPORT_POSIX)
+extern const transport_ops_t transport_posix;
+#define TRANSPORT_BACKEND transport_posix
+#elif defined(APP_TRANSPORT_LWIP)
+extern const transport_ops_t transport_lwip;
+#define TRANSPORT_BACKEND transport_lwip
+#else
+#define TRANSPORT_BACKEND transport_secure_sockets
+#endif
+
+// Envío completo reintentando envíos parciales; *total_sent cuenta lo enviado
+// aunque falle a la mitad
+cy_rslt_t transport_send_all(const transport_ops_t *ops, transport_conn_t *conn,
+                             const void *data, uint32_t len, uint32_t *total_sent);
+
+#endif /* TRANSPORT_H_ */
@@ -0,0 +1,494 @@
+#if defined(APP_TRANSPORT_LWIP)
+#include "cyhal.h"
+#include <FreeRTOS.h>
+#include <task.h>
+#include <semphr.h>
+#include <stdatomic.h>
+#include "lwip/tcp.h"
+#include "lwip/tcpip.h"
+#include "lwip/pbuf.h"
+#include "transport.h"
+#include "config.h"
+
+// Backend sobre la API raw de lwIP. tcp_accept/tcp_recv/tcp_sent/tcp_err
+// corren en el hilo tcpip; con un manejador de recepción (set_rx_handler) los
+// datos se entregan ahí mismo, directo desde la cadena de pbufs, sin el salto
+// de hilo ni la copia de secure sockets. Sin manejador, los pbufs esperan en
+// la conexión hasta que recv() los copia. Las operaciones desde tareas toman
+// el núcleo de lwIP con LOCK_TCPIP_CORE, igual que los callbacks lo tienen
+// tomado: todo el estado de una conexión se protege con ese candado.
+
+#if !LWIP_TCPIP_CORE_LOCKING
+#error "APP_TRANSPORT_LWIP necesita LWIP_TCPIP_CORE_LOCKING=1 en lwipopts.h"
+#endif
+
+#define LWIP_ACCEPT_BACKLOG 4
+#define LWIP_SEND_TIMEOUT_MS 10000 // Como el de secure sockets por defecto
+
+struct transport_conn
+{
+    atomic_bool in_use;
+    struct tcp_pcb *pcb; // NULL tras un error: lwIP ya lo liberó
+    bool listening;
+    bool nonblocking;
+    bool closed; // El otro extremo cerró o hubo error
+    uint32_t recv_timeout_ms;
+    struct pbuf *rx_chain; // Recibido sin manejador, pendiente de recv()
+    transport_rx_fn_t rx_fn;
+    void *rx_ctx;
+    transport_ready_fn_t ready_fn;
+    void *ready_ctx;
+    transport_conn_t *backlog[LWIP_ACCEPT_BACKLOG]; // Solo escucha: aceptadas en el hilo tcpip
+    uint8_t backlog_head;
+    uint8_t backlog_count;
+    SemaphoreHandle_t rx_signal; // Datos, conexión entrante o cierre
+    SemaphoreHandle_t tx_signal; // Espacio en el buffer de envío o cierre
+    StaticSemaphore_t rx_signal_buffer;
+    StaticSemaphore_t tx_signal_buffer;
+};
+
+static transport_conn_t conns[TRANSPORT_MAX_CONNECTIONS];
+
+static transport_conn_t *conn_claim(struct tcp_pcb *pcb)
+{
+    for (int i = 0; i < TRANSPORT_MAX_CONNECTIONS; i++)
+    {
+        transport_conn_t *conn = &conns[i];
+
+        if (!atomic_exchange_explicit(&conn->in_use, true, memory_order_acquire))
+        {
+            conn->pcb = pcb;
+            conn->listening = false;
+            conn->nonblocking = false;
+            conn->closed = false;
+            conn->recv_timeout_ms = TRANSPORT_WAIT_FOREVER;
+            conn->rx_chain = NULL;
+            conn->rx_fn = NULL;
+            conn->ready_fn = NULL;
+            conn->backlog_head = 0;
+            conn->backlog_count = 0;
+            xSemaphoreTake(conn->rx_signal, 0); // Señales de la conexión anterior
+            xSemaphoreTake(conn->tx_signal, 0);
+            return conn;
+        }
+    }
+    return NULL;
+}
+
+static void conn_signal(transport_conn_t *conn)
+{
+    xSemaphoreGive(conn->rx_signal);
+    if (conn->ready_fn != NULL)
+    {
+        conn->ready_fn(conn->ready_ctx);
+    }
+}
+
+// Espera una señal sin pasarse del plazo; false al vencer
+static bool conn_wait(SemaphoreHandle_t signal, TickType_t start, uint32_t timeout_ms)
+{
+    TickType_t wait = portMAX_DELAY;
+
+    if (timeout_ms != TRANSPORT_WAIT_FOREVER)
+    {
+        TickType_t elapsed = xTaskGetTickCount() - start;
+        if (elapsed >= pdMS_TO_TICKS(timeout_ms))
+        {
+            return false;
+        }
+        wait = pdMS_TO_TICKS(timeout_ms) - elapsed;
+    }
+    return xSemaphoreTake(signal, wait) == pdTRUE;
+}
+
+// CALLBACKS (hilo tcpip, núcleo tomado)
+
+static err_t lwip_on_recv(void *arg, struct tcp_pcb *pcb, struct pbuf *p, err_t err)
+{
+    transport_conn_t *conn = (transport_conn_t *)arg;
+
+    if (p == NULL)
+    {
+        conn->closed = true;
+        if (conn->rx_fn != NULL)
+        {
+            conn->rx_fn(conn->rx_ctx, NULL, 0, true);
+        }
+        xSemaphoreGive(conn->tx_signal);
+        conn_signal(conn);
+        return ERR_OK;
+    }
+
+    if (conn->rx_fn != NULL)
+    {
+        for (struct pbuf *q = p; q != NULL; q = q->next)
+        {
+            conn->rx_fn(conn->rx_ctx, (const uint8_t *)q->payload, q->len, q->next == NULL);
+        }
+        tcp_recved(pcb, p->tot_len);
+        pbuf_free(p);
+        return ERR_OK;
+    }
+
+    // La ventana se reabre cuando recv() consume
+    if (conn->rx_chain == NULL)
+    {
+        conn->rx_chain = p;
+    }
+    else
+    {
+        pbuf_cat(conn->rx_chain, p);
+    }
+    conn_signal(conn);
+    return ERR_OK;
+}
+
+static err_t lwip_on_sent(void *arg, struct tcp_pcb *pcb, u16_t len)
+{
+    transport_conn_t *conn = (transport_conn_t *)arg;
+
+    xSemaphoreGive(conn->tx_signal);
+    return ERR_OK;
+}
+
+static void lwip_on_err(void *arg, err_t err)
+{
+    transport_conn_t *conn = (transport_conn_t *)arg;
+
+    if (conn == NULL)
+    {
+        return;
+    }
+    conn->pcb = NULL;
+    conn->closed = true;
+    if (conn->rx_fn != NULL)
+    {
+        conn->rx_fn(conn->rx_ctx, NULL, 0, true);
+    }
+    xSemaphoreGive(conn->tx_signal);
+    conn_signal(conn);
+}
+
+static void lwip_attach(transport_conn_t *conn, struct tcp_pcb *pcb)
+{
+    tcp_arg(pcb, conn);
+    tcp_recv(pcb, lwip_on_recv);
+    tcp_sent(pcb, lwip_on_sent);
+    tcp_err(pcb, lwip_on_err);
+}
+
+static void lwip_detach(struct tcp_pcb *pcb)
+{
+    tcp_arg(pcb, NULL);
+    tcp_recv(pcb, NULL);
+    tcp_sent(pcb, NULL);
+    tcp_err(pcb, NULL);
+}
+
+// La conexión se adopta aquí mismo para no perder lo que llegue antes de accept()
+static err_t lwip_on_accept(void *arg, struct tcp_pcb *pcb, err_t err)
+{
+    transport_conn_t *listener = (transport_conn_t *)arg;
+    transport_conn_t *conn;
+
+    if (err != ERR_OK || pcb == NULL)
+    {
+        return ERR_VAL;
+    }
+    if (listener->backlog_count >= LWIP_ACCEPT_BACKLOG || (conn = conn_claim(pcb)) == NULL)
+    {
+        tcp_abort(pcb);
+        return ERR_ABRT;
+    }
+
+    lwip_attach(conn, pcb);
+    listener->backlog[(listener->backlog_head + listener->backlog_count) % LWIP_ACCEPT_BACKLOG] = conn;
+    listener->backlog_count++;
+    conn_signal(listener);
+    return ERR_OK;
+}
+
+// OPERACIONES (tareas)
+
+static cy_rslt_t lwip_init(void)
+{
+    static bool initialized = false;
+
+    // lwIP ya lo inicializó cy_wcm; aquí solo los semáforos de la tabla
+    if (!initialized)
+    {
+        for (int i = 0; i < TRANSPORT_MAX_CONNECTIONS; i++)
+        {
+            conns[i].rx_signal = xSemaphoreCreateBinaryStatic(&conns[i].rx_signal_buffer);
+            conns[i].tx_signal = xSemaphoreCreateBinaryStatic(&conns[i].tx_signal_buffer);
+        }
+        initialized = true;
+    }
+    return CY_RSLT_SUCCESS;
+}
+
+static cy_rslt_t lwip_listen(const transport_addr_t *addr, int backlog, bool nonblocking,
+                             transport_conn_t **listener)
+{
+    ip_addr_t ip;
+    struct tcp_pcb *pcb;
+    struct tcp_pcb *listen_pcb;
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    ip_addr_set_ip4_u32(&ip, addr->ipv4);
+
+    LOCK_TCPIP_CORE();
+    pcb = tcp_new_ip_type(IPADDR_TYPE_V4);
+    if (pcb == NULL)
+    {
+        result = CY_RSLT_MODULE_SECURE_SOCKETS_NOMEM;
+    }
+    else if (tcp_bind(pcb, &ip, addr->port) != ERR_OK)
+    {
+        tcp_close(pcb);
+        result = CY_RSLT_MODULE_SECURE_SOCKETS_ADDRESS_IN_USE;
+    }
+    else if ((listen_pcb = tcp_listen_with_backlog(pcb, (u8_t)backlog)) == NULL)
+    {
+        tcp_close(pcb);
+        result = CY_RSLT_MODULE_SECURE_SOCKETS_NOMEM;
+    }
+    else if ((*listener = conn_claim(listen_pcb)) == NULL)
+    {
+        tcp_close(listen_pcb);
+        result = CY_RSLT_MODULE_SECURE_SOCKETS_NOMEM;
+    }
+    else
+    {
+        (*listener)->listening = true;
+        (*listener)->nonblocking = nonblocking;
+        tcp_arg(listen_pcb, *listener);
+        tcp_accept(listen_pcb, lwip_on_accept);
+    }
+    UNLOCK_TCPIP_CORE();
+
+    return result;
+}
+
+static cy_rslt_t lwip_accept(transport_conn_t *listener, transport_conn_t **conn, transport_addr_t *peer)
+{
+    for (;;)
+    {
+        LOCK_TCPIP_CORE();
+        if (listener->backlog_count > 0)
+        {
+            *conn = listener->backlog[listener->backlog_head];
+            listener->backlog_head = (listener->backlog_head + 1) % LWIP_ACCEPT_BACKLOG;
+            listener->backlog_count--;
+
+            // Si ya se cayó, lwIP liberó el pcb: se entrega igual y recv() dirá CLOSED
+            peer->ipv4 = ((*conn)->pcb != NULL) ? ip4_addr_get_u32(ip_2_ip4(&(*conn)->pcb->remote_ip)) : 0;
+            peer->port = ((*conn)->pcb != NULL) ? (*conn)->pcb->remote_port : 0;
+            UNLOCK_TCPIP_CORE();
+            return CY_RSLT_SUCCESS;
+        }
+        UNLOCK_TCPIP_CORE();
+
+        if (listener->nonblocking)
+        {
+            return CY_RSLT_MODULE_SECURE_SOCKETS_TIMEOUT;
+        }
+        xSemaphoreTake(listener->rx_signal, portMAX_DELAY);
+    }
+}
+
+static cy_rslt_t lwip_recv(transport_conn_t *conn, void *data, uint32_t size, uint32_t *received)
+{
+    TickType_t start = xTaskGetTickCount();
+
+    *received = 0;
+    for (;;)
+    {
+        LOCK_TCPIP_CORE();
+        if (conn->rx_chain != NULL)
+        {
+            u16_t count = pbuf_copy_partial(conn->rx_chain, data,
+                                            (u16_t)((size < 0xFFFFu) ? size : 0xFFFFu), 0);
+            conn->rx_chain = pbuf_free_header(conn->rx_chain, count);
+            if (conn->pcb != NULL)
+            {
+                tcp_recved(conn->pcb, count);
+            }
+            UNLOCK_TCPIP_CORE();
+            *received = count;
+            return CY_RSLT_SUCCESS;
+        }
+        bool closed = conn->closed;
+        UNLOCK_TCPIP_CORE();
+
+        if (closed)
+        {
+            return CY_RSLT_MODULE_SECURE_SOCKETS_CLOSED;
+        }
+        if (!conn_wait(conn->rx_signal, start, conn->recv_timeout_ms))
+        {
+            return CY_RSLT_MODULE_SECURE_SOCKETS_TIMEOUT;
+        }
+    }
+}
+
+static cy_rslt_t lwip_send(transport_conn_t *conn, const void *data, uint32_t len, uint32_t *sent)
+{
+    TickType_t start = xTaskGetTickCount();
+
+    *sent = 0;
+    for (;;)
+    {
+        LOCK_TCPIP_CORE();
+        if (conn->pcb == NULL || conn->closed)
+        {
+            UNLOCK_TCPIP_CORE();
+            return CY_RSLT_MODULE_SECURE_SOCKETS_CLOSED;
+        }
+
+        u16_t count = tcp_sndbuf(conn->pcb);
+        if (count > len)
+        {
+            count = (u16_t)len;
+        }
+        if (count > 0 && tcp_write(conn->pcb, data, count, TCP_WRITE_FLAG_COPY) == ERR_OK)
+        {
+            tcp_output(conn->pcb);
+            UNLOCK_TCPIP_CORE();
+            *sent = count;
+            return CY_RSLT_SUCCESS;
+        }
+        UNLOCK_TCPIP_CORE();
+
+        // Sin espacio (o sin pbufs): esperar a que tcp_sent libere
+        if (!conn_wait(conn->tx_signal, start, LWIP_SEND_TIMEOUT_MS))
+        {
+            return CY_RSLT_MODULE_SECURE_SOCKETS_TIMEOUT;
+        }
+    }
+}
+
+static cy_rslt_t lwip_set_recv_timeout(transport_conn_t *conn, uint32_t timeout_ms)
+{
+    conn->recv_timeout_ms = timeout_ms;
+    return CY_RSLT_SUCCESS;
+}
+
+static cy_rslt_t lwip_set_nodelay(transport_conn_t *conn, bool nodelay)
+{
+    LOCK_TCPIP_CORE();
+    if (conn->pcb != NULL)
+    {
+        if (nodelay)
+        {
+            tcp_nagle_disable(conn->pcb);
+        }
+        else
+        {
+            tcp_nagle_enable(conn->pcb);
+        }
+    }
+    UNLOCK_TCPIP_CORE();
+    return CY_RSLT_SUCCESS;
+}
+
+static cy_rslt_t lwip_set_ready_callback(transport_conn_t *conn, transport_ready_fn_t fn, void *ctx)
+{
+    LOCK_TCPIP_CORE();
+    conn->ready_ctx = ctx;
+    conn->ready_fn = fn;
+    UNLOCK_TCPIP_CORE();
+    return CY_RSLT_SUCCESS;
+}
+
+static cy_rslt_t lwip_set_rx_handler(transport_conn_t *conn, transport_rx_fn_t fn, void *ctx)
+{
+    LOCK_TCPIP_CORE();
+    conn->rx_ctx = ctx;
+    conn->rx_fn = fn;
+
+    // Lo que llegó entre el accept y aquí se entrega ya, en esta tarea
+    if (fn != NULL && conn->rx_chain != NULL)
+    {
+        struct pbuf *p = conn->rx_chain;
+        conn->rx_chain = NULL;
+        for (struct pbuf *q = p; q != NULL; q = q->next)
+        {
+            fn(ctx, (const uint8_t *)q->payload, q->len, q->next == NULL);
+        }
+        if (conn->pcb != NULL)
+        {
+            tcp_recved(conn->pcb, p->tot_len);
+        }
+        pbuf_free(p);
+    }
+    if (fn != NULL && conn->closed)
+    {
+        fn(ctx, NULL, 0, true);
+    }
+    UNLOCK_TCPIP_CORE();
+    return CY_RSLT_SUCCESS;
+}
+
+static void lwip_close(transport_conn_t *conn)
+{
+    LOCK_TCPIP_CORE();
+    if (conn->listening)
+    {
+        // Conexiones adoptadas que nadie llegó a aceptar
+        while (conn->backlog_count > 0)
+        {
+            transport_conn_t *pending = conn->backlog[conn->backlog_head];
+            conn->backlog_head = (conn->backlog_head + 1) % LWIP_ACCEPT_BACKLOG;
+            conn->backlog_count--;
+            if (pending->pcb != NULL)
+            {
+                lwip_detach(pending->pcb);
+                tcp_abort(pending->pcb);
+            }
+            if (pending->rx_chain != NULL)
+            {
+                pbuf_free(pending->rx_chain);
+            }
+            atomic_store_explicit(&pending->in_use, false, memory_order_release);
+        }
+        tcp_arg(conn->pcb, NULL);
+        tcp_accept(conn->pcb, NULL);
+        tcp_close(conn->pcb);
+    }
+    else if (conn->pcb != NULL)
+    {
+        lwip_detach(conn->pcb);
+        if (tcp_close(conn->pcb) != ERR_OK)
+        {
+            tcp_abort(conn->pcb);
+        }
+    }
+
+    if (conn->rx_chain != NULL)
+    {
+        pbuf_free(conn->rx_chain);
+    }
+    conn->rx_chain = NULL;
+    conn->pcb = NULL;
+    conn->rx_fn = NULL;
+    conn->ready_fn = NULL;
+    UNLOCK_TCPIP_CORE();
+
+    atomic_store_explicit(&conn->in_use, false, memory_order_release);
+}
+
+const transport_ops_t transport_lwip = {
+    .name = "lwip_raw",
+    .init = lwip_init,
+    .listen = lwip_listen,
+    .accept = lwip_accept,
+    .recv = lwip_recv,
+    .send = lwip_send,
+    .set_recv_timeout = lwip_set_recv_timeout,
+    .set_nodelay = lwip_set_nodelay,
+    .set_ready_callback = lwip_set_ready_callback,
+    .set_rx_handler = lwip_set_rx_handler,
+    .close = lwip_close,
+};
+#endif /* APP_TRANSPORT_LWIP */
@@ -0,0 +1,271 @@
+#if defined(APP_TRANSPORT_POSIX)
+#include "cyhal.h"
+#include <FreeRTOS.h>
+#include <task.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "transport.h"
+#include "config.h"
+
+// Backend de sockets BSD para la simulación en Linux (host/Makefile,
+// TRANSPORT=posix). Los fd son no bloqueantes y las esperas son poll() +
+// vTaskDelay(1): una llamada bloqueante dentro de una tarea del port POSIX
+// detendría al scheduler entero. HOST_PORT_OFFSET se suma a cada puerto.
+
+struct transport_conn
+{
+    atomic_bool in_use;
+    int fd;
+    bool nonblocking;
+    uint32_t recv_timeout_ms;
+};
+
+#define POSIX_SEND_TIMEOUT_MS 10000 // Como el de secure sockets por defecto
+
+static transport_conn_t conns[TRANSPORT_MAX_CONNECTIONS];
+static uint16_t port_offset = 0;
+
+static transport_conn_t *conn_claim(int fd)
+{
+    for (int i = 0; i < TRANSPORT_MAX_CONNECTIONS; i++)
+    {
+        if (!atomic_exchange_explicit(&conns[i].in_use, true, memory_order_acquire))
+        {
+            fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+            conns[i].fd = fd;
+            conns[i].nonblocking = false;
+            conns[i].recv_timeout_ms = TRANSPORT_WAIT_FOREVER;
+            return &conns[i];
+        }
+    }
+    return NULL;
+}
+
+static cy_rslt_t errno_result(int err)
+{
+    switch (err)
+    {
+    case EAGAIN:
+        return CY_RSLT_MODULE_SECURE_SOCKETS_TIMEOUT;
+    case ECONNRESET:
+    case EPIPE:
+    case ENOTCONN:
+        return CY_RSLT_MODULE_SECURE_SOCKETS_CLOSED;
+    case EADDRINUSE:
+        return CY_RSLT_MODULE_SECURE_SOCKETS_ADDRESS_IN_USE;
+    case ENOMEM:
+    case ENOBUFS:
+    case EMFILE:
+        return CY_RSLT_MODULE_SECURE_SOCKETS_NOMEM;
+    case EBADF:
+        return CY_RSLT_MODULE_SECURE_SOCKETS_INVALID_SOCKET;
+    default:
+        return CY_RSLT_MODULE_SECURE_SOCKETS_TCPIP_ERROR;
+    }
+}
+
+// Espera a que el fd esté listo cediendo el CPU al resto de las tareas
+static cy_rslt_t wait_ready(transport_conn_t *conn, short events, uint32_t timeout_ms)
+{
+    TickType_t start = xTaskGetTickCount();
+
+    for (;;)
+    {
+        struct pollfd pfd = {.fd = conn->fd, .events = events};
+        int ready = poll(&pfd, 1, 0);
+
+        if (ready > 0)
+        {
+            return CY_RSLT_SUCCESS; // Errores y cierres los reporta la operación
+        }
+        if (ready < 0 && errno != EINTR)
+        {
+            return errno_result(errno);
+        }
+        if (conn->nonblocking ||
+            (timeout_ms != TRANSPORT_WAIT_FOREVER &&
+             (xTaskGetTickCount() - start) >= pdMS_TO_TICKS(timeout_ms)))
+        {
+            return CY_RSLT_MODULE_SECURE_SOCKETS_TIMEOUT;
+        }
+        vTaskDelay(1);
+    }
+}
+
+static cy_rslt_t posix_init(void)
+{
+    const char *offset = getenv("HOST_PORT_OFFSET");
+
+    port_offset = (offset != NULL) ? (uint16_t)atoi(offset) : 0;
+    return CY_RSLT_SUCCESS;
+}
+
+static cy_rslt_t posix_listen(const transport_addr_t *addr, int backlog, bool nonblocking,
+                              transport_conn_t **listener)
+{
+    struct sockaddr_in sockaddr = {
+        .sin_family = AF_INET,
+        .sin_port = htons((uint16_t)(addr->port + port_offset)),
+        .sin_addr.s_addr = addr->ipv4};
+    int reuse = 1; // Reiniciar la simulación sin esperar TIME_WAIT
+    int fd = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+
+    if (fd < 0)
+    {
+        return errno_result(errno);
+    }
+
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    if (bind(fd, (struct sockaddr *)&sockaddr, sizeof(sockaddr)) != 0 || listen(fd, backlog) != 0)
+    {
+        cy_rslt_t result = errno_result(errno);
+        printf("TRANSPORT: puerto %u: %s\n", ntohs(sockaddr.sin_port), strerror(errno));
+        close(fd);
+        return result;
+    }
+
+    if ((*listener = conn_claim(fd)) == NULL)
+    {
+        close(fd);
+        return CY_RSLT_MODULE_SECURE_SOCKETS_NOMEM;
+    }
+    (*listener)->nonblocking = nonblocking;
+    return CY_RSLT_SUCCESS;
+}
+
+static cy_rslt_t posix_accept(transport_conn_t *listener, transport_conn_t **conn, transport_addr_t *peer)
+{
+    cy_rslt_t result = wait_ready(listener, POLLIN, TRANSPORT_WAIT_FOREVER);
+
+    if (result != CY_RSLT_SUCCESS)
+    {
+        return result;
+    }
+
+    struct sockaddr_in peer_addr;
+    socklen_t peer_len = sizeof(peer_addr);
+    int fd = accept(listener->fd, (struct sockaddr *)&peer_addr, &peer_len);
+    if (fd < 0)
+    {
+        return errno_result(errno);
+    }
+
+    if ((*conn = conn_claim(fd)) == NULL)
+    {
+        close(fd);
+        return CY_RSLT_MODULE_SECURE_SOCKETS_NOMEM;
+    }
+
+    peer->ipv4 = peer_addr.sin_addr.s_addr;
+    peer->port = ntohs(peer_addr.sin_port);
+    return CY_RSLT_SUCCESS;
+}
+
+static cy_rslt_t posix_recv(transport_conn_t *conn, void *data, uint32_t size, uint32_t *received)
+{
+    *received = 0;
+    for (;;)
+    {
+        cy_rslt_t result = wait_ready(conn, POLLIN, conn->recv_timeout_ms);
+        if (result != CY_RSLT_SUCCESS)
+        {
+            return result;
+        }
+
+        ssize_t len = recv(conn->fd, data, size, 0);
+        if (len > 0)
+        {
+            *received = (uint32_t)len;
+            return CY_RSLT_SUCCESS;
+        }
+        if (len == 0)
+        {
+            return CY_RSLT_MODULE_SECURE_SOCKETS_CLOSED;
+        }
+        if (errno != EAGAIN && errno != EINTR)
+        {
+            return errno_result(errno);
+        }
+    }
+}
+
+static cy_rslt_t posix_send(transport_conn_t *conn, const void *data, uint32_t len, uint32_t *sent)
+{
+    *sent = 0;
+    for (;;)
+    {
+        cy_rslt_t result = wait_ready(conn, POLLOUT, POSIX_SEND_TIMEOUT_MS);
+        if (result != CY_RSLT_SUCCESS)
+        {
+            return result;
+        }
+
+        ssize_t count = send(conn->fd, data, len, MSG_NOSIGNAL);
+        if (count >= 0)
+        {
+            *sent = (uint32_t)count;
+            return CY_RSLT_SUCCESS;
+        }
+        if (errno != EAGAIN && errno != EINTR)
+        {
+            return errno_result(errno);
+        }
+    }
+}
+
+static cy_rslt_t posix_set_recv_timeout(transport_conn_t *conn, uint32_t timeout_ms)
+{
+    conn->recv_timeout_ms = timeout_ms;
+    return CY_RSLT_SUCCESS;
+}
+
+static cy_rslt_t posix_set_nodelay(transport_conn_t *conn, bool nodelay)
+{
+    int value = nodelay ? 1 : 0;
+    return (setsockopt(conn->fd, IPPROTO_TCP, TCP_NODELAY, &value, sizeof(value)) == 0)
+               ? CY_RSLT_SUCCESS
+               : errno_result(errno);
+}
+
+// Sin hilo propio que vigile los fd: el servidor sondea
+static cy_rslt_t posix_set_ready_callback(transport_conn_t *conn, transport_ready_fn_t fn, void *ctx)
+{
+    return CY_RSLT_MODULE_SECURE_SOCKETS_PROTOCOL_NOT_SUPPORTED;
+}
+
+static cy_rslt_t posix_set_rx_handler(transport_conn_t *conn, transport_rx_fn_t fn, void *ctx)
+{
+    return CY_RSLT_MODULE_SECURE_SOCKETS_PROTOCOL_NOT_SUPPORTED;
+}
+
+static void posix_close(transport_conn_t *conn)
+{
+    shutdown(conn->fd, SHUT_RDWR);
+    close(conn->fd);
+    conn->fd = -1;
+    atomic_store_explicit(&conn->in_use, false, memory_order_release);
+}
+
+const transport_ops_t transport_posix = {
+    .name = "posix",
+    .init = posix_init,
+    .listen = posix_listen,
+    .accept = posix_accept,
+    .recv = posix_recv,
+    .send = posix_send,
+    .set_recv_timeout = posix_set_recv_timeout,
+    .set_nodelay = posix_set_nodelay,
+    .set_ready_callback = posix_set_ready_callback,
+    .set_rx_handler = posix_set_rx_handler,
+    .close = posix_close,
+};
+#endif /* APP_TRANSPORT_POSIX */
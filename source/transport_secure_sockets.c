@@ -0,0 +1,191 @@
+#include "cyhal.h"
+#include "cy_secure_sockets.h"
+#include <stdatomic.h>
+#include "transport.h"
+#include "config.h"
+
+// Backend sobre cy_secure_sockets (lwIP detrás de su propio hilo). Las
+// conexiones salen de una tabla estática: nada se asigna al aceptar.
+
+struct transport_conn
+{
+    atomic_bool in_use;
+    cy_socket_t socket;
+    bool listening;
+    transport_ready_fn_t ready_fn;
+    void *ready_ctx;
+};
+
+static transport_conn_t conns[TRANSPORT_MAX_CONNECTIONS];
+
+static transport_conn_t *conn_claim(cy_socket_t socket)
+{
+    for (int i = 0; i < TRANSPORT_MAX_CONNECTIONS; i++)
+    {
+        if (!atomic_exchange_explicit(&conns[i].in_use, true, memory_order_acquire))
+        {
+            conns[i].socket = socket;
+            conns[i].listening = false;
+            conns[i].ready_fn = NULL;
+            conns[i].ready_ctx = NULL;
+            return &conns[i];
+        }
+    }
+    return NULL;
+}
+
+static void conn_release(transport_conn_t *conn)
+{
+    conn->socket = CY_SOCKET_INVALID_HANDLE;
+    atomic_store_explicit(&conn->in_use, false, memory_order_release);
+}
+
+static cy_rslt_t ss_init(void)
+{
+    return cy_socket_init();
+}
+
+static cy_rslt_t ss_listen(const transport_addr_t *addr, int backlog, bool nonblocking,
+                           transport_conn_t **listener)
+{
+    cy_socket_sockaddr_t sockaddr = {
+        .port = addr->port,
+        .ip_address = {.version = CY_SOCKET_IP_VER_V4, .ip.v4 = addr->ipv4}};
+    cy_socket_t socket;
+    cy_rslt_t result;
+
+    result = cy_socket_create(CY_SOCKET_DOMAIN_AF_INET, CY_SOCKET_TYPE_STREAM,
+                              CY_SOCKET_IPPROTO_TCP, &socket);
+    if (result != CY_RSLT_SUCCESS)
+    {
+        return result;
+    }
+
+    if (nonblocking)
+    {
+        uint32_t value = 1;
+        cy_socket_setsockopt(socket, CY_SOCKET_SOL_SOCKET, CY_SOCKET_SO_NONBLOCK,
+                             &value, sizeof(value));
+    }
+
+    result = cy_socket_bind(socket, &sockaddr, sizeof(sockaddr));
+    if (result == CY_RSLT_SUCCESS)
+    {
+        result = cy_socket_listen(socket, backlog);
+    }
+    if (result == CY_RSLT_SUCCESS && (*listener = conn_claim(socket)) == NULL)
+    {
+        result = CY_RSLT_MODULE_SECURE_SOCKETS_NOMEM;
+    }
+    if (result != CY_RSLT_SUCCESS)
+    {
+        cy_socket_delete(socket);
+        return result;
+    }
+
+    (*listener)->listening = true;
+    return CY_RSLT_SUCCESS;
+}
+
+static cy_rslt_t ss_accept(transport_conn_t *listener, transport_conn_t **conn, transport_addr_t *peer)
+{
+    cy_socket_sockaddr_t peer_addr;
+    uint32_t peer_len = sizeof(peer_addr);
+    cy_socket_t socket;
+    cy_rslt_t result;
+
+    result = cy_socket_accept(listener->socket, &peer_addr, &peer_len, &socket);
+    if (result != CY_RSLT_SUCCESS)
+    {
+        return result;
+    }
+
+    if ((*conn = conn_claim(socket)) == NULL)
+    {
+        cy_socket_disconnect(socket, 0);
+        cy_socket_delete(socket);
+        return CY_RSLT_MODULE_SECURE_SOCKETS_NOMEM;
+    }
+
+    peer->ipv4 = peer_addr.ip_address.ip.v4;
+    peer->port = peer_addr.port;
+    return CY_RSLT_SUCCESS;
+}
+
+static cy_rslt_t ss_recv(transport_conn_t *conn, void *data, uint32_t size, uint32_t *received)
+{
+    return cy_socket_recv(conn->socket, data, size, CY_SOCKET_FLAGS_NONE, received);
+}
+
+static cy_rslt_t ss_send(transport_conn_t *conn, const void *data, uint32_t len, uint32_t *sent)
+{
+    return cy_socket_send(conn->socket, data, len, CY_SOCKET_FLAGS_NONE, sent);
+}
+
+static cy_rslt_t ss_set_recv_timeout(transport_conn_t *conn, uint32_t timeout_ms)
+{
+    return cy_socket_setsockopt(conn->socket, CY_SOCKET_SOL_SOCKET, CY_SOCKET_SO_RCVTIMEO,
+                                &timeout_ms, sizeof(timeout_ms));
+}
+
+static cy_rslt_t ss_set_nodelay(transport_conn_t *conn, bool nodelay)
+{
+    uint32_t value = nodelay ? 1 : 0;
+    return cy_socket_setsockopt(conn->socket, CY_SOCKET_SOL_TCP, CY_SOCKET_SO_TCP_NODELAY,
+                                &value, sizeof(value));
+}
+
+// Corre en el hilo de secure sockets
+static cy_rslt_t ss_ready_trampoline(cy_socket_t socket, void *arg)
+{
+    transport_conn_t *conn = (transport_conn_t *)arg;
+    transport_ready_fn_t fn = conn->ready_fn;
+
+    if (fn != NULL)
+    {
+        fn(conn->ready_ctx);
+    }
+    return CY_RSLT_SUCCESS;
+}
+
+static cy_rslt_t ss_set_ready_callback(transport_conn_t *conn, transport_ready_fn_t fn, void *ctx)
+{
+    cy_socket_opt_callback_t callback = {
+        .callback = (fn != NULL) ? ss_ready_trampoline : NULL,
+        .arg = conn};
+
+    conn->ready_ctx = ctx;
+    conn->ready_fn = fn;
+    return cy_socket_setsockopt(conn->socket, CY_SOCKET_SOL_SOCKET,
+                                conn->listening ? CY_SOCKET_SO_CONNECT_REQUEST_CALLBACK
+                                                : CY_SOCKET_SO_RECEIVE_CALLBACK,
+                                &callback, sizeof(callback));
+}
+
+// Secure sockets solo entrega por recv()
+static cy_rslt_t ss_set_rx_handler(transport_conn_t *conn, transport_rx_fn_t fn, void *ctx)
+{
+    return CY_RSLT_MODULE_SECURE_SOCKETS_PROTOCOL_NOT_SUPPORTED;
+}
+
+static void ss_close(transport_conn_t *conn)
+{
+    conn->ready_fn = NULL;
+    cy_socket_disconnect(conn->socket, 0);
+    cy_socket_delete(conn->socket);
+    conn_release(conn);
+}
+
+const transport_ops_t transport_secure_sockets = {
+    .name = "secure_sockets",
+    .init = ss_init,
+    .listen = ss_listen,
+    .accept = ss_accept,
+    .recv = ss_recv,
+    .send = ss_send,
+    .set_recv_timeout = ss_set_recv_timeout,
+    .set_nodelay = ss_set_nodelay,
+    .set_ready_callback = ss_set_ready_callback,
+    .set_rx_handler = ss_set_rx_handler,
+    .close = ss_close,
+};
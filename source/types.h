@@ -4,6 +4,7 @@
 
 #include "cyhal.h"
 #include <stdbool.h>
+#include "command.h"
 
 // Comandos para comunicación entre tareas
 typedef enum {
@@ -12,18 +13,37 @@ typedef enum {
     CMD_IA_TO_TCP = 3
 } command_type_t;
 
+// Etapas de un comando TCP, en orden (latency_monitor.h)
+typedef enum {
+    LATENCY_RECV = 0,        // recv del transporte devolvió el comando
+    LATENCY_ENQUEUE,         // Parseado, entra a queue_tcp_to_control
+    LATENCY_DEQUEUE,         // Control lo saca de la cola
+    LATENCY_LOOKUP,          // Control decodificó el descriptor
+    LATENCY_GPIO,            // apply_command_bitmask terminado (solo actuación)
+    LATENCY_REPLY_ENQUEUE,   // Respuesta entra a queue_control_to_tcp
+    LATENCY_REPLY_DEQUEUE,   // Cliente saca la respuesta de la cola
+    LATENCY_REPLY_SENT,      // send de la respuesta terminado
+    LATENCY_STAMP_COUNT
+} latency_stamp_t;
+
 // Estructura de mensaje para colas
 typedef struct {
     command_type_t command;
-    uint32_t value;  // ID de cliente o otros datos
-    char data[64];   // Datos del mensaje
+    uint32_t value;  // ID de cliente (0 = comando por voz, la respuesta se difunde)
+    command_desc_t cmd; // Comando parseado; en la respuesta, el comando atendido
+    uint8_t outputs;    // Respuesta: salidas encendidas tras el comando (bit 0 = salida 1)
+    uint32_t enqueue_cycles; // Marca de queue_monitor_send (tiempo en cola)
+    uint32_t stamps[LATENCY_STAMP_COUNT]; // Ciclos por etapa (0 = etapa no ocurrió)
 } message_t;
 
+// Cola instrumentada (queue_monitor.h)
+typedef struct monitored_queue monitored_queue_t;
+
 // Parámetros para las tareas (punteros a colas)
 typedef struct {
-    QueueHandle_t queue_tcp_to_control;
-    QueueHandle_t queue_control_to_tcp;
-    QueueHandle_t queue_ia_to_tcp;
+    monitored_queue_t *queue_tcp_to_control;
+    monitored_queue_t *queue_control_to_tcp;
+    monitored_queue_t *queue_ia_to_tcp;
 } task_params_t;
 
 #endif /* TYPES_H_ */
\ No newline at end of file
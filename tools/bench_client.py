@@ -0,0 +1,171 @@
+#!/usr/bin/env python3
+"""
+Cliente de los servicios de prueba de red (firmware compilado con
+APP_BENCH_SERVICES). Mide el camino Wi-Fi/lwIP/secure-sockets sin el protocolo
+de control:
+
+    python3 tools/bench_client.py 192.168.1.50 discard -t 10     # subida, Mbps
+    python3 tools/bench_client.py 192.168.1.50 chargen -t 10     # bajada, Mbps
+    python3 tools/bench_client.py 192.168.1.50 echo -t 10        # ida y vuelta, Mbps
+    python3 tools/bench_client.py 192.168.1.50 pingpong -n 2000  # RTT en us
+    python3 tools/bench_client.py 192.168.1.50 all
+
+Los puertos son los de BENCH_*_PORT en source/config.h.
+"""
+import argparse
+import socket
+import struct
+import sys
+import threading
+import time
+
+PORTS = {"echo": 7, "discard": 9, "chargen": 19, "pingpong": 5999}
+
+# Igual que bench_serve_pingpong() en source/tcp_server.c
+PINGPONG_FRAME = struct.Struct("<I4xQII8x")
+assert PINGPONG_FRAME.size == 32
+
+
+def connect(host, port, timeout):
+    sock = socket.create_connection((host, port), timeout=timeout)
+    sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+    return sock
+
+
+def mbps(nbytes, seconds):
+    return nbytes * 8 / seconds / 1e6 if seconds > 0 else 0.0
+
+
+def percentile(sorted_values, fraction):
+    if not sorted_values:
+        return 0.0
+    index = min(len(sorted_values) - 1, int(fraction * len(sorted_values)))
+    return sorted_values[index]
+
+
+def run_discard(args):
+    payload = b"\xa5" * args.size
+    sent = 0
+    with connect(args.host, PORTS["discard"], args.timeout) as sock:
+        start = time.perf_counter()
+        deadline = start + args.time
+        while time.perf_counter() < deadline:
+            sock.sendall(payload)
+            sent += len(payload)
+        sock.shutdown(socket.SHUT_WR)
+        sock.recv(1)                    # Espera el cierre: todo llegó a la placa
+        elapsed = time.perf_counter() - start
+    print("discard  subida  %10d bytes  %7.2f s  %7.2f Mbps" % (sent, elapsed, mbps(sent, elapsed)))
+
+
+def run_chargen(args):
+    received = 0
+    with connect(args.host, PORTS["chargen"], args.timeout) as sock:
+        start = time.perf_counter()
+        deadline = start + args.time
+        while time.perf_counter() < deadline:
+            chunk = sock.recv(65536)
+            if not chunk:
+                break
+            received += len(chunk)
+        elapsed = time.perf_counter() - start
+    print("chargen  bajada  %10d bytes  %7.2f s  %7.2f Mbps" % (received, elapsed, mbps(received, elapsed)))
+
+
+def run_echo(args):
+    payload = bytes(range(256)) * (args.size // 256 + 1)
+    payload = payload[:args.size]
+    sent = [0]
+    received = 0
+
+    with connect(args.host, PORTS["echo"], args.timeout) as sock:
+        start = time.perf_counter()
+        deadline = start + args.time
+
+        def writer():
+            while time.perf_counter() < deadline:
+                sock.sendall(payload)
+                sent[0] += len(payload)
+            sock.shutdown(socket.SHUT_WR)
+
+        thread = threading.Thread(target=writer, daemon=True)
+        thread.start()
+        while True:
+            chunk = sock.recv(65536)
+            if not chunk:
+                break
+            received += len(chunk)
+            if not thread.is_alive() and received >= sent[0]:
+                break
+        thread.join()
+        elapsed = time.perf_counter() - start
+
+    status = "ok" if received == sent[0] else "FALTAN %d bytes" % (sent[0] - received)
+    print("echo     eco     %10d bytes  %7.2f s  %7.2f Mbps (cada sentido)  %s" %
+          (received, elapsed, mbps(received, elapsed), status))
+
+
+def run_pingpong(args):
+    rtts = []
+    board = []
+    with connect(args.host, PORTS["pingpong"], args.timeout) as sock:
+        for seq in range(args.count):
+            t0 = time.perf_counter_ns()
+            sock.sendall(PINGPONG_FRAME.pack(seq, t0, 0, 0))
+            data = b""
+            while len(data) < PINGPONG_FRAME.size:
+                chunk = sock.recv(PINGPONG_FRAME.size - len(data))
+                if not chunk:
+                    raise RuntimeError("conexion cerrada en la trama %d" % seq)
+                data += chunk
+            t1 = time.perf_counter_ns()
+
+            rseq, rt0, proc_us, _uptime_ms = PINGPONG_FRAME.unpack(data)
+            if rseq != seq or rt0 != t0:
+                raise RuntimeError("trama %d desordenada (llego %d)" % (seq, rseq))
+            rtts.append((t1 - t0) / 1000.0)
+            if seq > 0:
+                board.append(proc_us)       # Tiempo en placa de la trama anterior
+            if args.interval:
+                time.sleep(args.interval / 1000.0)
+
+    rtts.sort()
+    board.sort()
+    if not board:
+        board = [0]
+    print("pingpong %d tramas de %d bytes, RTT en us:" % (len(rtts), PINGPONG_FRAME.size))
+    print("  red+placa  min %8.0f  p50 %8.0f  p90 %8.0f  p99 %8.0f  p999 %8.0f  max %8.0f" %
+          (rtts[0], percentile(rtts, 0.5), percentile(rtts, 0.9), percentile(rtts, 0.99),
+           percentile(rtts, 0.999), rtts[-1]))
+    print("  en placa   min %8d  p50 %8d  p90 %8d  p99 %8d  p999 %8d  max %8d" %
+          (board[0], percentile(board, 0.5), percentile(board, 0.9), percentile(board, 0.99),
+           percentile(board, 0.999), board[-1]))
+
+
+TESTS = {"discard": run_discard, "chargen": run_chargen, "echo": run_echo, "pingpong": run_pingpong}
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Prueba de red contra los servicios de la placa")
+    parser.add_argument("host", help="IP de la placa")
+    parser.add_argument("test", choices=list(TESTS) + ["all"])
+    parser.add_argument("-t", "--time", type=float, default=10.0, help="segundos por prueba de caudal")
+    parser.add_argument("-s", "--size", type=int, default=1460, help="bytes por envio")
+    parser.add_argument("-n", "--count", type=int, default=1000, help="tramas de ping-pong")
+    parser.add_argument("-i", "--interval", type=float, default=0.0, help="ms entre tramas de ping-pong")
+    parser.add_argument("--timeout", type=float, default=15.0)
+    args = parser.parse_args()
+
+    tests = list(TESTS) if args.test == "all" else [args.test]
+    failed = False
+    for name in tests:
+        try:
+            TESTS[name](args)
+        except (OSError, RuntimeError) as exc:
+            print("%-8s error: %s" % (name, exc), file=sys.stderr)
+            failed = True
+    sys.exit(1 if failed else 0)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,364 @@
+#!/usr/bin/env python3
+"""
+Genera las tablas constantes del front-end de audio (en flash).
+
+Escribe source/models/model1audio_tables.h con:
+  - Las tablas de la rdft de Ooura para 512 puntos: ip (nw, nc y los índices
+    de bit-reversal) y w (twiddles y cosenos), calculadas como makewt/makect
+    con la misma aritmética float32, para que rdft no las arme en RAM al
+    procesar la primera trama.
+  - La tabla dispersa de pesos mel del front-end fusionado
+    (APP_FRONTEND_FUSED), a partir de los puntos de los filtros (_K23) del
+    modelo exportado por DEEPCRAFT (source/models/model1audio.c): para cada
+    bin entre el primer y el último punto, el segmento al que pertenece y
+    los pesos de subida (banda del segmento) y de bajada (banda anterior),
+    ya redondeados a float32 como los calcula __mel_f32.
+  - Para el front-end en punto fijo (APP_FRONTEND_Q15): la ventana de Hann del
+    modelo (_K11) en Q31, los mismos pesos mel en Q15 sin signo (1.0 = 32768)
+    y la tabla de ln(1 + i/128) en Q24 para el logaritmo interpolado.
+  - El tipo y la cuantización (escala y punto cero) de los tensores de
+    entrada y salida del modelo TFLite embebido (_K7). Con una entrada int8
+    (MODEL_INPUT_INT8) model1audio_frontend.inc cuantiza las features y guarda
+    el anillo en int8; con una salida int8 decuantiza los puntajes.
+
+Volver a ejecutarlo después de reexportar el modelo:
+
+    python3 tools/gen_frontend_tables.py
+    python3 tools/gen_frontend_tables.py --check   # falla si el .h no está al día
+"""
+import argparse
+import math
+import os
+import re
+import struct
+import sys
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+MODEL_C = os.path.join(ROOT, "source", "models", "model1audio.c")
+TABLES_H = os.path.join(ROOT, "source", "models", "model1audio_tables.h")
+
+MEL_BANDS = 30
+FFT_SIZE = 512
+FFT_BINS = FFT_SIZE // 2 + 1
+LN_TABLE_BITS = 7
+
+TABLE_RE = re.compile(r"static const (?:ALIGNED\(16\) )?uint32_t %s\[\] = \{([^}]*)\};")
+
+# TensorType del esquema TFLite
+TFLITE_TYPES = {0: "float32", 9: "int8"}
+
+
+def read_words(source, symbol):
+    match = re.search(TABLE_RE.pattern % re.escape(symbol), source)
+    if match is None:
+        sys.exit("%s no encontrado en %s" % (symbol, MODEL_C))
+    return [int(word, 16) for word in re.findall(r"0x[0-9a-fA-F]+", match.group(1))]
+
+
+def filter_points(source):
+    points = []
+    for word in read_words(source, "_K23"):
+        points.append(struct.unpack("<h", struct.pack("<I", word)[0:2])[0])
+        points.append(struct.unpack("<h", struct.pack("<I", word)[2:4])[0])
+    if len(points) != MEL_BANDS + 2 or points != sorted(points) or points[-1] >= FFT_BINS:
+        sys.exit("_K23 no son %d puntos crecientes dentro de %d bins" % (MEL_BANDS + 2, FFT_BINS))
+    return points
+
+
+class FlatTable:
+    """Tabla de un flatbuffer: lo justo del esquema TFLite para leer tensores."""
+
+    def __init__(self, data, offset):
+        self.data = data
+        self.offset = offset
+        self.vtable = offset - struct.unpack_from("<i", data, offset)[0]
+        self.vtable_size = struct.unpack_from("<H", data, self.vtable)[0]
+
+    def field(self, index):
+        if 4 + 2 * index >= self.vtable_size:
+            return None
+        offset = struct.unpack_from("<H", self.data, self.vtable + 4 + 2 * index)[0]
+        return self.offset + offset if offset else None
+
+    def table(self, index):
+        offset = self.field(index)
+        return None if offset is None else FlatTable(self.data, deref(self.data, offset))
+
+    def vector(self, index, fmt):
+        offset = self.field(index)
+        if offset is None:
+            return []
+        start = deref(self.data, offset)
+        count = struct.unpack_from("<I", self.data, start)[0]
+        size = struct.calcsize(fmt)
+        return [struct.unpack_from(fmt, self.data, start + 4 + size * i)[0] for i in range(count)]
+
+    def tables(self, index):
+        return [FlatTable(self.data, deref(self.data, offset)) for offset in self.vector_offsets(index)]
+
+    def vector_offsets(self, index):
+        offset = self.field(index)
+        if offset is None:
+            return []
+        start = deref(self.data, offset)
+        count = struct.unpack_from("<I", self.data, start)[0]
+        return [start + 4 + 4 * i for i in range(count)]
+
+    def scalar(self, index, fmt, default=0):
+        offset = self.field(index)
+        return default if offset is None else struct.unpack_from(fmt, self.data, offset)[0]
+
+
+def deref(data, offset):
+    return offset + struct.unpack_from("<I", data, offset)[0]
+
+
+def model_io(source):
+    """(tipo, forma, escala, punto cero) de la entrada y la salida del modelo."""
+    data = b"".join(struct.pack("<I", word) for word in read_words(source, "_K7"))
+    model = FlatTable(data, deref(data, 0))
+    subgraph = model.tables(2)[0]   # Model.subgraphs
+    tensors = subgraph.tables(0)    # SubGraph.tensors
+    io = []
+    for index in (1, 2):            # SubGraph.inputs, SubGraph.outputs
+        tensor = tensors[subgraph.vector(index, "<i")[0]]
+        kind = tensor.scalar(1, "<b")  # Tensor.type
+        if kind not in TFLITE_TYPES:
+            sys.exit("tensor de tipo TFLite %d no soportado" % kind)
+        quantization = tensor.table(4)  # Tensor.quantization: scale (2), zero_point (3)
+        scale = quantization.vector(2, "<f") if quantization else []
+        zero_point = quantization.vector(3, "<q") if quantization else []
+        if TFLITE_TYPES[kind] == "int8" and (len(scale) != 1 or len(zero_point) != 1):
+            sys.exit("tensor int8 sin cuantización por tensor")
+        io.append((TFLITE_TYPES[kind], tensor.vector(0, "<i"),  # Tensor.shape
+                   scale[0] if scale else None, zero_point[0] if zero_point else None))
+    return io
+
+
+def io_defines(io):
+    lines = ["// Tensores del modelo (_K7): entrada %s %s, salida %s %s" %
+             (io[0][0], io[0][1], io[1][0], io[1][1])]
+    for name, (kind, _, scale, zero_point) in zip(("INPUT", "OUTPUT"), io):
+        lines.append("#define MODEL_%s_INT8 %d" % (name, kind == "int8"))
+        if kind == "int8":
+            lines.append("#define MODEL_%s_SCALE %s" % (name, f32_literal(scale)))
+            lines.append("#define MODEL_%s_ZERO_POINT %d" % (name, zero_point))
+    return lines
+
+
+def f32(value):
+    return struct.unpack("<f", struct.pack("<f", value))[0]
+
+
+def f32_literal(value):
+    return "%.9ef" % f32(value)
+
+
+def fft_tables(n):
+    """ip y w de rdft(n), como makeipt/makewt/makect en float32."""
+    nw = nc = n >> 2
+    ip = [nw, nc, 0, 16]
+    w = [0.0] * (nw + nc)
+
+    # makeipt
+    m = 2
+    l = nw
+    while l > 32:
+        m2 = m << 1
+        q = m2 << 3
+        ip.extend([0] * (m2 + m2 - len(ip)))
+        for j in range(m, m2):
+            p = ip[j] << 2
+            ip[m + j] = p
+            ip[m2 + j] = p + q
+        m = m2
+        l >>= 2
+
+    # makewt: delta y los productos por j son float, cos/sin en double
+    nwh = nw >> 1
+    delta = f32(math.atan(1.0) / nwh)
+    wn4r = f32(math.cos(f32(delta * nwh)))
+    w[0] = 1.0
+    w[1] = wn4r
+    w[2] = f32(0.5 / math.cos(f32(delta * 2)))
+    w[3] = f32(0.5 / math.cos(f32(delta * 6)))
+    for j in range(4, nwh, 4):
+        w[j] = f32(math.cos(f32(delta * j)))
+        w[j + 1] = f32(math.sin(f32(delta * j)))
+        w[j + 2] = f32(math.cos(f32(f32(3 * delta) * j)))
+        w[j + 3] = f32(-math.sin(f32(f32(3 * delta) * j)))
+    nw0 = 0
+    while nwh > 2:
+        nw1 = nw0 + nwh
+        nwh >>= 1
+        w[nw1] = 1.0
+        w[nw1 + 1] = wn4r
+        if nwh == 4:
+            w[nw1 + 2] = w[nw0 + 4]
+            w[nw1 + 3] = w[nw0 + 5]
+        elif nwh > 4:
+            w[nw1 + 2] = f32(0.5 / w[nw0 + 4])
+            w[nw1 + 3] = f32(0.5 / w[nw0 + 6])
+            for j in range(4, nwh, 4):
+                w[nw1 + j:nw1 + j + 4] = w[nw0 + 2 * j:nw0 + 2 * j + 4]
+        nw0 = nw1
+
+    # makect, sobre w + nw
+    nch = nc >> 1
+    delta = f32(math.atan(1.0) / nch)
+    c0 = f32(math.cos(f32(delta * nch)))
+    w[nw] = c0
+    w[nw + nch] = f32(0.5 * c0)
+    for j in range(1, nch):
+        w[nw + j] = f32(0.5 * math.cos(f32(delta * j)))
+        w[nw + nc - j] = f32(0.5 * math.sin(f32(delta * j)))
+    return ip, w
+
+
+def float_rows(values, per_row):
+    return ["    " + ", ".join(f32_literal(v) for v in values[i:i + per_row]) + ","
+            for i in range(0, len(values), per_row)]
+
+
+def mel_table(points):
+    """(segmento, subida, bajada) por bin en [points[0], points[-1])."""
+    rows = []
+    for segment in range(len(points) - 1):
+        start, end = points[segment], points[segment + 1]
+        width = end - start
+        for k in range(start, end):
+            rise = f32((k - start) / width)
+            rows.append((segment, rise, f32(1.0 - rise)))
+    return rows
+
+
+def hann_q31(source):
+    """_K11 (float32) en Q31, saturado a 0x7fffffff."""
+    window = [struct.unpack("<f", struct.pack("<I", word))[0] for word in read_words(source, "_K11")]
+    if len(window) != FFT_SIZE:
+        sys.exit("_K11 no tiene %d muestras" % FFT_SIZE)
+    return [min(round(value * 2 ** 31), 0x7fffffff) for value in window]
+
+
+def q15_weight(value):
+    return round(value * 32768)
+
+
+def ln_table_q24():
+    return [round(math.log(1.0 + i / 2 ** LN_TABLE_BITS) * 2 ** 24) for i in range(2 ** LN_TABLE_BITS + 1)]
+
+
+def int_rows(values, per_row, fmt="%d"):
+    return ["    " + ", ".join(fmt % v for v in values[i:i + per_row]) + ","
+            for i in range(0, len(values), per_row)]
+
+
+def render(ip, w, points, rows, io, hann):
+    nw, nc = ip[0], ip[1]
+    lines = [
+        "#ifndef MODEL1AUDIO_TABLES_H_",
+        "#define MODEL1AUDIO_TABLES_H_",
+        "",
+        "// Generado por tools/gen_frontend_tables.py a partir de model1audio.c; no editar.",
+        "",
+        "// rdft de %d puntos: ip = {nw, nc, bit-reversal}, w = nw twiddles y nc cosenos" % FFT_SIZE,
+        "#define FFT%d_NW %d" % (FFT_SIZE, nw),
+        "#define FFT%d_NC %d" % (FFT_SIZE, nc),
+        "",
+        "static const int32_t fft%d_ip[%d] = {%s};" % (FFT_SIZE, len(ip), ", ".join(str(i) for i in ip)),
+        "",
+        "static const float fft%d_w[FFT%d_NW + FFT%d_NC] = {" % (FFT_SIZE, FFT_SIZE, FFT_SIZE),
+    ]
+    lines.extend(float_rows(w, 4))
+    lines.extend(["};", ""])
+    lines.extend(io_defines(io))
+    lines.extend([
+        "",
+        "#if defined(APP_FRONTEND_FUSED) || defined(APP_FRONTEND_Q15)",
+        "// Filtros mel: puntos %s" % ", ".join(str(p) for p in points),
+        "#define MEL_FIRST_BIN %d" % points[0],
+        "#define MEL_TABLE_BINS %d" % len(rows),
+        "#define MEL_SEGMENTS %d // El segmento s sube la banda s y baja la s - 1" % (len(points) - 1),
+        "",
+        "static const uint8_t mel_segment[MEL_TABLE_BINS] = {",
+    ])
+    lines.extend(int_rows([row[0] for row in rows], 16))
+    lines.extend([
+        "};",
+        "#endif",
+        "",
+        "#if defined(APP_FRONTEND_FUSED)",
+        "typedef struct {",
+        "    float rise; // Peso en la banda del segmento",
+        "    float fall; // Peso en la banda anterior",
+        "} mel_weight_t;",
+        "",
+        "static const mel_weight_t mel_weight[MEL_TABLE_BINS] = {",
+    ])
+    for i in range(0, len(rows), 3):
+        lines.append("    " + " ".join("{%s, %s}," % (f32_literal(r[1]), f32_literal(r[2]))
+                                        for r in rows[i:i + 3]))
+    lines.append("};")
+    lines.append("#endif /* APP_FRONTEND_FUSED */")
+    lines.append("")
+    lines.extend([
+        "#if defined(APP_FRONTEND_Q15)",
+        "// Ventana de Hann (_K11) en Q31",
+        "static const int32_t hann%d_q31[%d] = {" % (FFT_SIZE, FFT_SIZE),
+    ])
+    lines.extend(int_rows(hann, 6))
+    lines.extend([
+        "};",
+        "",
+        "// Pesos mel en Q15 sin signo: 1.0 = 32768",
+        "typedef struct {",
+        "    uint16_t rise;",
+        "    uint16_t fall;",
+        "} mel_weight_q15_t;",
+        "",
+        "static const mel_weight_q15_t mel_weight_q15[MEL_TABLE_BINS] = {",
+    ])
+    for i in range(0, len(rows), 6):
+        lines.append("    " + " ".join("{%d, %d}," % (q15_weight(r[1]), q15_weight(r[2]))
+                                        for r in rows[i:i + 6]))
+    lines.extend([
+        "};",
+        "",
+        "// ln(1 + i / %d) en Q24, una entrada más para interpolar la última" % 2 ** LN_TABLE_BITS,
+        "#define LN_TABLE_BITS %d" % LN_TABLE_BITS,
+        "static const int32_t ln_table_q24[(1 << LN_TABLE_BITS) + 1] = {",
+    ])
+    lines.extend(int_rows(ln_table_q24(), 8))
+    lines.append("};")
+    lines.append("#endif /* APP_FRONTEND_Q15 */")
+    lines.append("")
+    lines.append("#endif /* MODEL1AUDIO_TABLES_H_ */")
+    return "\n".join(lines) + "\n"
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Tablas constantes del front-end de audio")
+    parser.add_argument("--check", action="store_true", help="no escribe; falla si el .h difiere")
+    args = parser.parse_args()
+
+    with open(MODEL_C, encoding="utf-8") as f:
+        source = f.read()
+    points = filter_points(source)
+    ip, w = fft_tables(FFT_SIZE)
+    io = model_io(source)
+    text = render(ip, w, points, mel_table(points), io, hann_q31(source))
+
+    if args.check:
+        with open(TABLES_H, encoding="utf-8") as f:
+            if f.read() != text:
+                sys.exit("%s no está al día: ejecutar tools/gen_frontend_tables.py" % TABLES_H)
+        return
+
+    with open(TABLES_H, "w", encoding="utf-8") as f:
+        f.write(text)
+    print("%s: rdft de %d, %d bins mel, %d bandas, entrada %s" % (os.path.relpath(TABLES_H, ROOT), FFT_SIZE,
+                                                                  points[-1] - points[0], MEL_BANDS, io[0][0]))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,221 @@
+#!/usr/bin/env python3
+"""
+Análisis estático de pila por tarea.
+
+Combina la salida de -fstack-usage / -fcallgraph-info=su (compilar con
+`make build STACK_USAGE=1`) con el grafo de llamadas para obtener el peor caso
+de pila desde la función de entrada de cada tarea. Opcionalmente mezcla el pico
+observado en el equipo (salida del comando STACKS guardada en un archivo) y
+recomienda un tamaño por tarea.
+
+    python3 tools/stack_usage.py build
+    python3 tools/stack_usage.py build --runtime stacks.txt --margin 25
+"""
+import argparse
+import os
+import re
+import sys
+
+# Tarea -> (función de entrada, macro de config.h con el tamaño en palabras)
+TASKS = {
+    "TCP_Server": ("tarea_TCPserver", "TCP_SERVER_TASK_STACK_SIZE"),
+    "Cliente_":   ("client_task", "CLIENT_TASK_STACK_SIZE"),
+    "IA_Task":    ("tarea_ia", "IA_TASK_STACK_SIZE"),
+    "Controlpin": ("control", "CONTROL_TASK_STACK_SIZE"),
+}
+
+WORD_BYTES = 4          # sizeof(StackType_t) en Cortex-M4
+ROUND_BYTES = 256       # Igual que STACK_ROUND_WORDS en stack_monitor.c
+# Marco de excepción con FPU (8 + 18 palabras) + registros guardados por
+# el cambio de contexto de FreeRTOS (r4-r11, lr, s16-s31)
+CONTEXT_OVERHEAD = 208
+
+NODE_RE = re.compile(r'node:\s*\{\s*title:\s*"([^"]+)"\s*label:\s*"([^"]*)"(.*)\}')
+EDGE_RE = re.compile(r'edge:\s*\{\s*sourcename:\s*"([^"]+)"\s*targetname:\s*"([^"]+)"')
+SIZE_RE = re.compile(r'(\d+) bytes \(([a-z,]+)\)')
+
+
+class Function:
+    def __init__(self, title, name, unit, size, kind):
+        self.title = title        # Las funciones static llevan "archivo:nombre"
+        self.name = name
+        self.unit = unit
+        self.size = size
+        self.kind = kind          # static | dynamic | dynamic,bounded
+        self.callees = []         # nombres sin resolver
+        self.indirect = False
+
+
+def load_callgraph(build_dir):
+    """Lee todos los .ci; devuelve {(unidad, nombre): Function}."""
+    functions = {}
+    edges = []
+    for root, _, files in os.walk(build_dir):
+        for name in files:
+            if not name.endswith(".ci"):
+                continue
+            unit = os.path.join(root, name)
+            with open(unit, encoding="utf-8", errors="replace") as f:
+                for line in f:
+                    m = NODE_RE.search(line)
+                    if m:
+                        size = SIZE_RE.search(m.group(2))
+                        if size:  # Nodo definido en esta unidad
+                            name = m.group(2).split("\\n")[0]
+                            functions[(unit, m.group(1))] = Function(
+                                m.group(1), name, unit, int(size.group(1)), size.group(2))
+                        continue
+                    m = EDGE_RE.search(line)
+                    if m:
+                        edges.append((unit, m.group(1), m.group(2)))
+
+    for unit, src, dst in edges:
+        fn = functions.get((unit, src))
+        if fn is None:
+            continue
+        if dst == "__indirect_call":
+            fn.indirect = True
+        else:
+            fn.callees.append(dst)
+    return functions
+
+
+def build_resolver(functions):
+    by_name = {}
+    by_title = {}
+    for fn in functions.values():
+        by_name.setdefault(fn.name, []).append(fn)
+        by_title.setdefault(fn.title, []).append(fn)
+
+    def resolve(unit, title):
+        fn = functions.get((unit, title))  # Preferir la definición local (static)
+        if fn:
+            return fn
+        candidates = by_title.get(title) or by_name.get(title, [])
+        return candidates[0] if len(candidates) == 1 else None
+
+    return by_name, resolve
+
+
+def worst_case(entry, resolve):
+    """Peor caso de pila desde entry. Devuelve (bytes, camino, avisos)."""
+    memo = {}
+    warnings = set()
+
+    def visit(fn, stack):
+        key = (fn.unit, fn.title)
+        if key in memo:
+            return memo[key]
+        if key in stack:
+            warnings.add("recursion en " + fn.name)
+            return 0, [fn.name + " (recursivo)"]
+        if fn.indirect:
+            warnings.add("llamada indirecta en " + fn.name)
+        if fn.kind != "static":
+            warnings.add("pila %s en %s" % (fn.kind, fn.name))
+
+        stack.add(key)
+        best, best_path = 0, []
+        for callee in fn.callees:
+            target = resolve(fn.unit, callee)
+            if target is None:
+                warnings.add("sin datos de " + callee)
+                continue
+            size, path = visit(target, stack)
+            if size > best:
+                best, best_path = size, path
+        stack.discard(key)
+
+        memo[key] = (fn.size + best, [fn.name] + best_path)
+        return memo[key]
+
+    size, path = visit(entry, set())
+    return size, path, sorted(warnings)
+
+
+def read_config_sizes(config_path):
+    sizes = {}
+    if not os.path.exists(config_path):
+        return sizes
+    with open(config_path, encoding="utf-8", errors="replace") as f:
+        for line in f:
+            m = re.match(r'\s*#define\s+(\w+_STACK_SIZE)\s+\(?\s*([0-9 *()]+?)\s*\)?\s*(//.*)?$', line)
+            if m:
+                try:
+                    sizes[m.group(1)] = int(eval(m.group(2), {"__builtins__": {}}))
+                except Exception:
+                    pass
+    return sizes
+
+
+def read_runtime(path):
+    """Lee la tabla del comando STACKS: TAREA CONFIG PICO RECOM (bytes)."""
+    peaks = {}
+    with open(path, encoding="utf-8", errors="replace") as f:
+        for line in f:
+            parts = line.split()
+            if len(parts) == 4 and all(p.isdigit() for p in parts[1:]):
+                peaks[parts[0]] = int(parts[2])
+    return peaks
+
+
+def round_up(value):
+    return (value + ROUND_BYTES - 1) // ROUND_BYTES * ROUND_BYTES
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Peor caso de pila por tarea")
+    parser.add_argument("build_dir", help="directorio con los .ci/.su generados")
+    parser.add_argument("--config", default=os.path.join(os.path.dirname(__file__), "..", "source", "config.h"))
+    parser.add_argument("--runtime", help="salida del comando STACKS guardada en un archivo")
+    parser.add_argument("--margin", type=int, default=25, help="margen en %% (por defecto 25)")
+    parser.add_argument("--overhead", type=int, default=CONTEXT_OVERHEAD,
+                        help="bytes por cambio de contexto/excepción (por defecto %d)" % CONTEXT_OVERHEAD)
+    parser.add_argument("-v", "--verbose", action="store_true", help="mostrar camino y avisos")
+    args = parser.parse_args()
+
+    functions = load_callgraph(args.build_dir)
+    if not functions:
+        sys.exit("No se encontraron archivos .ci en %s (compilar con STACK_USAGE=1)" % args.build_dir)
+
+    by_name, resolve = build_resolver(functions)
+    config = read_config_sizes(args.config)
+    runtime = read_runtime(args.runtime) if args.runtime else {}
+
+    print("%-12s %9s %10s %9s %9s" % ("TAREA", "CONFIG", "ESTATICO", "PICO", "RECOM"))
+    total_config = total_recom = 0
+    for task, (entry_name, macro) in TASKS.items():
+        configured = config.get(macro, 0) * WORD_BYTES
+        entries = by_name.get(entry_name)
+        if not entries:
+            print("%-12s  función de entrada '%s' no encontrada" % (task, entry_name))
+            continue
+
+        static, path, warnings = worst_case(entries[0], resolve)
+        static += args.overhead
+        peak = runtime.get(task, 0)
+        bounded = not any(w.startswith(("recursion", "llamada indirecta", "pila dynamic ", "sin datos"))
+                          for w in warnings)
+
+        # Sin cota estática el pico observado es la única referencia superior
+        need = max(static, peak)
+        recommended = round_up(need * (100 + args.margin) // 100)
+        total_config += configured
+        total_recom += recommended
+
+        print("%-12s %9d %9d%s %9s %9d" % (task, configured, static, " " if bounded else "*",
+                                            peak if peak else "-", recommended))
+        if args.verbose:
+            print("    camino: " + " -> ".join(path))
+            for w in warnings:
+                print("    aviso: " + w)
+
+    print("\n* grafo no acotado (recursión, llamadas indirectas, pila dinámica o funciones")
+    print("  sin .ci, p. ej. newlib precompilada):")
+    print("  el valor estático es una cota inferior; usar --runtime con la salida de STACKS.")
+    if total_config:
+        print("Total configurado %d bytes, recomendado %d bytes (por instancia)" % (total_config, total_recom))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,229 @@
+#!/usr/bin/env python3
+"""
+Convierte la traza del kernel (firmware compilado con APP_TRACE_RECORDER) al
+formato JSON de Chrome tracing, que abren ui.perfetto.dev y chrome://tracing.
+
+La captura se obtiene con el comando TRACE_DUMP, directamente del equipo o de
+un archivo con la salida guardada:
+
+    python3 tools/trace_to_perfetto.py --host 192.168.1.50 -o traza.json
+    python3 tools/trace_to_perfetto.py --input volcado.txt -o traza.json
+
+Pistas generadas:
+  CPU     una fila por tarea con sus intervalos de ejecución, operaciones de
+          cola, herencia de prioridad y una fila ISR para el callback del PDM
+          y las operaciones de cola hechas desde interrupciones
+  Mutex   una fila por mutex con el tiempo que lo retiene cada tarea
+  Esperas tiempo bloqueado de cada tarea esperando un mutex
+"""
+import argparse
+import json
+import socket
+import sys
+
+# Igual que TRACE_EVT_* en source/trace_recorder_hooks.h
+EVT_TASK_SWITCH = 1
+EVT_QUEUE_SEND = 2
+EVT_QUEUE_RECEIVE = 3
+EVT_QUEUE_BLOCK_SEND = 4
+EVT_QUEUE_BLOCK_RECV = 5
+EVT_QUEUE_SEND_FAIL = 6
+EVT_QUEUE_RECV_FAIL = 7
+EVT_MUTEX_GIVE = 8
+EVT_MUTEX_TAKE = 9
+EVT_MUTEX_BLOCK = 10
+EVT_MUTEX_TIMEOUT = 11
+EVT_PRIO_INHERIT = 12
+EVT_PRIO_DISINHERIT = 13
+EVT_ISR_ENTER = 14
+EVT_ISR_EXIT = 15
+EVT_USER = 16
+
+QUEUE_EVENTS = {
+    EVT_QUEUE_SEND: "envia",
+    EVT_QUEUE_RECEIVE: "recibe",
+    EVT_QUEUE_BLOCK_SEND: "bloquea envio",
+    EVT_QUEUE_BLOCK_RECV: "bloquea recepcion",
+    EVT_QUEUE_SEND_FAIL: "cola llena",
+    EVT_QUEUE_RECV_FAIL: "cola vacia",
+}
+
+TASK_ISR = 0xFF
+TID_ISR = 0             # uxTCBNumber empieza en 1
+
+# Ids de ISR propias (TRACE_ISR_* en source/trace_recorder.h)
+ISR_NAMES = {1: "PDM"}
+PID_CPU = 1
+PID_MUTEX = 2
+PID_WAIT = 3
+
+
+def capture(host, port, timeout):
+    """Pide TRACE_DUMP al servidor y devuelve el texto entre TRACE_BEGIN y TRACE_END."""
+    with socket.create_connection((host, port), timeout=timeout) as sock:
+        data = b""
+        while not data.endswith(b"> "):      # Mensaje de bienvenida
+            chunk = sock.recv(4096)
+            if not chunk:
+                raise RuntimeError("conexion cerrada antes del prompt")
+            data += chunk
+        sock.sendall(b"TRACE_DUMP\n")
+        data = b""
+        while b"TRACE_END\n" not in data:
+            chunk = sock.recv(65536)
+            if not chunk:
+                raise RuntimeError("conexion cerrada durante el volcado")
+            data += chunk
+    return data.decode("ascii", errors="replace")
+
+
+def parse_dump(text):
+    hz = None
+    lost = 0
+    tasks = {}
+    queues = {}
+    events = []
+
+    for line in text.splitlines():
+        line = line.strip()
+        if line.startswith("TRACE_BEGIN"):
+            fields = dict(f.split("=") for f in line.split()[1:])
+            hz = int(fields["hz"])
+            lost = int(fields["lost"])
+        elif line.startswith("T "):
+            parts = line.split(maxsplit=2)
+            tasks[int(parts[1])] = parts[2] if len(parts) > 2 else "tarea %s" % parts[1]
+        elif line.startswith("Q "):
+            parts = line.split(maxsplit=2)
+            queues[int(parts[1])] = parts[2]
+        elif line.startswith("E "):
+            hexdata = line[2:]
+            for i in range(0, len(hexdata) - 15, 16):
+                item = hexdata[i:i + 16]
+                events.append((int(item[0:8], 16), int(item[8:10], 16),
+                               int(item[10:12], 16), int(item[12:16], 16)))
+
+    if hz is None:
+        raise ValueError("no se encontro TRACE_BEGIN en la captura")
+    return hz, lost, tasks, queues, events
+
+
+def to_chrome(hz, tasks, queues, events):
+    out = []
+
+    def meta(pid, tid, kind, name):
+        out.append({"ph": "M", "pid": pid, "tid": tid, "name": kind, "args": {"name": name}})
+
+    def task_name(tid):
+        return "ISR" if tid == TID_ISR else tasks.get(tid, "tarea %d" % tid)
+
+    def queue_name(num):
+        return queues.get(num, "cola %d" % num)
+
+    meta(PID_CPU, 0, "process_name", "CPU")
+    meta(PID_MUTEX, 0, "process_name", "Mutex")
+    meta(PID_WAIT, 0, "process_name", "Esperas")
+    for num, name in queues.items():
+        meta(PID_MUTEX, num, "thread_name", name)
+
+    running = None          # (tarea, ts)
+    holds = {}              # mutex -> (tarea, ts)
+    waits = {}              # (tarea, mutex) -> ts
+    seen = set()
+    wraps = 0
+    prev_cycles = None
+
+    for cycles, etype, field, arg in events:
+        # El contador de 32 bits da la vuelta; los eventos están en orden
+        if prev_cycles is not None and cycles < prev_cycles:
+            wraps += 1
+        prev_cycles = cycles
+        ts = ((wraps << 32) + cycles) * 1e6 / hz
+
+        # Cambios y herencia de prioridad llevan el uxTCBNumber en arg; el
+        # resto es de la tarea en ejecución o de una interrupción
+        if etype in (EVT_TASK_SWITCH, EVT_PRIO_INHERIT, EVT_PRIO_DISINHERIT):
+            task = arg
+        elif field == TASK_ISR or etype in (EVT_ISR_ENTER, EVT_ISR_EXIT):
+            task = TID_ISR
+        elif running is not None:
+            task = running[0]
+        else:
+            continue        # Antes del primer cambio de contexto del volcado
+        seen.add(task)
+
+        if etype == EVT_TASK_SWITCH:
+            if running is not None:
+                out.append({"ph": "X", "pid": PID_CPU, "tid": running[0], "ts": running[1],
+                            "dur": ts - running[1], "name": task_name(running[0])})
+            running = (task, ts)
+        elif etype in QUEUE_EVENTS:
+            out.append({"ph": "i", "s": "t", "pid": PID_CPU, "tid": task, "ts": ts,
+                        "name": "%s %s" % (QUEUE_EVENTS[etype], queue_name(arg))})
+        elif etype == EVT_MUTEX_TAKE:
+            holds[arg] = (task, ts)
+            if (task, arg) in waits:
+                start = waits.pop((task, arg))
+                out.append({"ph": "X", "pid": PID_WAIT, "tid": task, "ts": start, "dur": ts - start,
+                            "name": "espera %s" % queue_name(arg)})
+        elif etype == EVT_MUTEX_GIVE:
+            if arg in holds:
+                owner, start = holds.pop(arg)
+                out.append({"ph": "X", "pid": PID_MUTEX, "tid": arg, "ts": start, "dur": ts - start,
+                            "name": task_name(owner)})
+        elif etype == EVT_MUTEX_BLOCK:
+            waits.setdefault((task, arg), ts)
+        elif etype == EVT_MUTEX_TIMEOUT:
+            start = waits.pop((task, arg), ts)
+            out.append({"ph": "X", "pid": PID_WAIT, "tid": task, "ts": start, "dur": ts - start,
+                        "name": "timeout %s" % queue_name(arg)})
+        elif etype in (EVT_PRIO_INHERIT, EVT_PRIO_DISINHERIT):
+            label = "hereda" if etype == EVT_PRIO_INHERIT else "restaura"
+            out.append({"ph": "i", "s": "t", "pid": PID_CPU, "tid": task, "ts": ts,
+                        "name": "%s prioridad %d" % (label, field)})
+        elif etype == EVT_ISR_ENTER:
+            out.append({"ph": "B", "pid": PID_CPU, "tid": TID_ISR, "ts": ts, "name": "ISR %s" % ISR_NAMES.get(arg, arg)})
+        elif etype == EVT_ISR_EXIT:
+            out.append({"ph": "E", "pid": PID_CPU, "tid": TID_ISR, "ts": ts})
+        elif etype == EVT_USER:
+            out.append({"ph": "i", "s": "t", "pid": PID_CPU, "tid": task, "ts": ts,
+                        "name": "marca %d" % arg})
+
+    for tid in sorted(seen):
+        meta(PID_CPU, tid, "thread_name", task_name(tid))
+        meta(PID_WAIT, tid, "thread_name", task_name(tid))
+
+    return {"traceEvents": out, "displayTimeUnit": "ns"}
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Traza del kernel a formato Chrome/Perfetto")
+    parser.add_argument("--host", help="IP del servidor (captura en vivo con TRACE_DUMP)")
+    parser.add_argument("--port", type=int, default=599)
+    parser.add_argument("--input", help="archivo con la salida de TRACE_DUMP")
+    parser.add_argument("--save", help="guardar también el volcado crudo")
+    parser.add_argument("--timeout", type=float, default=10.0)
+    parser.add_argument("-o", "--output", default="traza.json")
+    args = parser.parse_args()
+
+    if args.host:
+        text = capture(args.host, args.port, args.timeout)
+        if args.save:
+            with open(args.save, "w") as f:
+                f.write(text)
+    elif args.input:
+        with open(args.input) as f:
+            text = f.read()
+    else:
+        parser.error("indicar --host o --input")
+
+    hz, lost, tasks, queues, events = parse_dump(text)
+    with open(args.output, "w") as f:
+        json.dump(to_chrome(hz, tasks, queues, events), f)
+
+    print("%d eventos (%d perdidos), %d tareas, %d colas -> %s" %
+          (len(events), lost, len(tasks), len(queues), args.output), file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()